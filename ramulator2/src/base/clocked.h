@@ -23,6 +23,17 @@ class Clocked {
   public:
     virtual void tick() = 0;
 
+    /**
+     * @brief    Number of upcoming ticks that would only advance the clock (and per-cycle statistics) if nothing new
+     *           arrives in between, i.e., that can be replaced by skip_idle_ticks(). 0 means the next tick may do work.
+     */
+    virtual Clk_t get_num_idle_ticks() { return 0; };
+
+    /**
+     * @brief    Fast-forwards n ticks, n must not exceed get_num_idle_ticks().
+     */
+    virtual void skip_idle_ticks(Clk_t n) { m_clk += n; };
+
   public:
     Clocked() {};
 };
@@ -30,6 +30,11 @@ struct Request {
 
   int command = -1;          // The command that need to be issued to progress the request
   int final_command = -1;    // The final command that is needed to finish the request
+
+  // Scheduler cache of the prerequisite command and the cycle it becomes ready (see IDRAM::get_state_version)
+  int preq_command = -1;
+  Clk_t preq_ready_clk = -1;
+  uint64_t preq_version = -1;
   bool is_stat_updated = false; // Memory controller stats
 
   Clk_t arrive = -1;   // Clock cycle when the request arrive at the memory controller
@@ -43,6 +48,7 @@ struct Request {
 
   void* m_payload = nullptr;    // Point to a generic payload
 
+  Request() = default;
   Request(Addr_t addr, int type, int source_id); // added for new custom_trace impl
 
   Request(Addr_t addr, int type);
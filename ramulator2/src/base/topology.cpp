@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <numeric>
+
+#include "base/topology.h"
+#include "base/exception.h"
+
+namespace Ramulator {
+
+void NUMATopology::init(const YAML::Node& config) {
+  std::string type = config && config["type"] ? config["type"].as<std::string>() : "ring";
+
+  if (type == "ring") {
+    init_ring_or_mesh(config, false);
+  } else if (type == "mesh") {
+    init_ring_or_mesh(config, true);
+  } else if (type == "sockets") {
+    init_sockets(config);
+  } else if (type == "matrix") {
+    init_matrix(config);
+  } else {
+    throw ConfigurationError("Unknown Topology type {}! Expected ring, mesh, sockets, or matrix.", type);
+  }
+
+  m_channels_by_distance.resize(m_num_cores * m_num_channels);
+  for (int core = 0; core < m_num_cores; core++) {
+    auto first = m_channels_by_distance.begin() + core * m_num_channels;
+    auto last = first + m_num_channels;
+    std::iota(first, last, 0);
+    std::stable_sort(first, last, [this, core](int a, int b) { return get_latency(core, a) < get_latency(core, b); });
+  }
+}
+
+void NUMATopology::init_ring_or_mesh(const YAML::Node& config, bool is_mesh) {
+  m_num_cores = config && config["num_cores"] ? config["num_cores"].as<int>() : 8;
+  m_num_channels = config && config["num_channels"] ? config["num_channels"].as<int>() : 8;
+  std::vector<int> hop_latencies = config && config["hop_latencies"] ? config["hop_latencies"].as<std::vector<int>>() : std::vector<int>{20, 30, 60, 100, 130};
+  if (m_num_cores <= 0 || m_num_channels <= 0) {
+    throw ConfigurationError("Topology needs at least one core and one channel!");
+  }
+  if (hop_latencies.empty()) {
+    throw ConfigurationError("Topology hop_latencies must not be empty!");
+  }
+
+  int num_columns = m_num_channels;
+  if (is_mesh) {
+    num_columns = config["mesh_columns"] ? config["mesh_columns"].as<int>() : (int)std::ceil(std::sqrt(m_num_channels));
+    if (num_columns <= 0) {
+      throw ConfigurationError("Topology mesh_columns must be positive!");
+    }
+  }
+
+  int last_step = hop_latencies.size() > 1 ? hop_latencies.back() - hop_latencies[hop_latencies.size() - 2] : 0;
+  m_latencies.resize(m_num_cores * m_num_channels);
+  for (int core = 0; core < m_num_cores; core++) {
+    int stop = (int)((int64_t)core * m_num_channels / m_num_cores);
+    for (int ch = 0; ch < m_num_channels; ch++) {
+      int hops;
+      if (is_mesh) {
+        hops = std::abs(stop / num_columns - ch / num_columns) + std::abs(stop % num_columns - ch % num_columns);
+      } else {
+        int offset = std::abs(stop - ch);
+        hops = std::min(offset, m_num_channels - offset);
+      }
+      int extra_hops = hops - ((int)hop_latencies.size() - 1);
+      m_latencies[core * m_num_channels + ch] = extra_hops > 0 ? hop_latencies.back() + extra_hops * last_step : hop_latencies[hops];
+    }
+  }
+}
+
+void NUMATopology::init_sockets(const YAML::Node& config) {
+  m_num_cores = config["num_cores"] ? config["num_cores"].as<int>() : 8;
+  m_num_channels = config["num_channels"] ? config["num_channels"].as<int>() : 8;
+  int num_sockets = config["num_sockets"] ? config["num_sockets"].as<int>() : 2;
+  if (num_sockets <= 0 || m_num_cores < num_sockets || m_num_channels < num_sockets) {
+    throw ConfigurationError("Topology needs at least one core and one channel per socket!");
+  }
+
+  std::vector<std::vector<int>> socket_latencies;
+  if (config["socket_latencies"]) {
+    socket_latencies = config["socket_latencies"].as<std::vector<std::vector<int>>>();
+  } else {
+    int local_latency = config["local_latency"] ? config["local_latency"].as<int>() : 20;
+    int remote_latency = config["remote_latency"] ? config["remote_latency"].as<int>() : 100;
+    socket_latencies.assign(num_sockets, std::vector<int>(num_sockets, remote_latency));
+    for (int socket = 0; socket < num_sockets; socket++) {
+      socket_latencies[socket][socket] = local_latency;
+    }
+  }
+  if ((int)socket_latencies.size() != num_sockets) {
+    throw ConfigurationError("Topology socket_latencies has {} rows, expected {}!", socket_latencies.size(), num_sockets);
+  }
+  for (const auto& row : socket_latencies) {
+    if ((int)row.size() != num_sockets) {
+      throw ConfigurationError("Topology socket_latencies has a row of {} entries, expected {}!", row.size(), num_sockets);
+    }
+  }
+
+  m_latencies.resize(m_num_cores * m_num_channels);
+  for (int core = 0; core < m_num_cores; core++) {
+    int core_socket = (int)((int64_t)core * num_sockets / m_num_cores);
+    for (int ch = 0; ch < m_num_channels; ch++) {
+      int channel_socket = (int)((int64_t)ch * num_sockets / m_num_channels);
+      m_latencies[core * m_num_channels + ch] = socket_latencies[core_socket][channel_socket];
+    }
+  }
+}
+
+void NUMATopology::init_matrix(const YAML::Node& config) {
+  if (!config["latencies"]) {
+    throw ConfigurationError("Topology of type matrix needs the latencies of every core to every channel!");
+  }
+  auto latencies = config["latencies"].as<std::vector<std::vector<int>>>();
+  m_num_cores = latencies.size();
+  m_num_channels = latencies.empty() ? 0 : latencies[0].size();
+  if (m_num_cores == 0 || m_num_channels == 0) {
+    throw ConfigurationError("Topology needs at least one core and one channel!");
+  }
+
+  m_latencies.clear();
+  for (const auto& row : latencies) {
+    if ((int)row.size() != m_num_channels) {
+      throw ConfigurationError("Topology latencies has a row of {} entries, expected {}!", row.size(), m_num_channels);
+    }
+    m_latencies.insert(m_latencies.end(), row.begin(), row.end());
+  }
+}
+
+}        // namespace Ramulator
@@ -0,0 +1,61 @@
+#ifndef     RAMULATOR_BASE_TOPOLOGY_H
+#define     RAMULATOR_BASE_TOPOLOGY_H
+
+#include <span>
+#include <string>
+#include <vector>
+
+#include <yaml-cpp/yaml.h>
+
+namespace Ramulator {
+
+/**
+ * @brief    Distances (in memory cycles) between every core and every memory channel of the simulated system.
+ *
+ * @details
+ * Set up from the top-level "Topology" section of the configuration. The distances are either given directly or
+ * generated from a description of the system:
+ *   - ring (default):  one channel per ring stop, the distance of a channel h hops away is hop_latencies[h].
+ *   - mesh:            one channel per mesh stop (mesh_columns wide), h is the Manhattan distance.
+ *   - sockets:         cores and channels are split evenly across the sockets, socket_latencies[i][j] is the
+ *                      distance from a core of socket i to a channel of socket j (e.g., the ACPI SLIT table).
+ *   - matrix:          latencies[core][channel] is given explicitly.
+ * For ring and mesh, the cores are spread evenly over the stops. Distances beyond the end of hop_latencies keep
+ * growing by its last step. Without a Topology section, this is the 8-core x 8-channel ring used so far.
+ *
+ * The channels of each core, sorted by distance, are precomputed so that placement policies can look them up in O(1).
+ */
+class NUMATopology {
+  private:
+    int m_num_cores = 0;
+    int m_num_channels = 0;
+
+    std::vector<int> m_latencies;           // Per core x channel
+    std::vector<int> m_channels_by_distance;  // Per core, all channels from the nearest to the farthest (ties by id)
+
+  public:
+    void init(const YAML::Node& config);
+
+    int get_num_cores() const { return m_num_cores; };
+    int get_num_channels() const { return m_num_channels; };
+    bool is_core(int source_id) const { return source_id >= 0 && source_id < m_num_cores; };
+
+    int get_latency(int core, int channel) const { return m_latencies[core * m_num_channels + channel]; };
+    int get_nearest_channel(int core) const { return m_channels_by_distance[core * m_num_channels]; };
+    int get_min_latency(int core) const { return get_latency(core, get_nearest_channel(core)); };
+    std::span<const int> get_channels_by_distance(int core) const {
+      return {m_channels_by_distance.data() + core * m_num_channels, (size_t)m_num_channels};
+    };
+
+  private:
+    void init_ring_or_mesh(const YAML::Node& config, bool is_mesh);
+    void init_sockets(const YAML::Node& config);
+    void init_matrix(const YAML::Node& config);
+};
+
+// The core-to-channel topology of the simulated system, set up before the frontend and the memory system are created
+inline NUMATopology numa_topology;
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_BASE_TOPOLOGY_H
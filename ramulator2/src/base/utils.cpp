@@ -108,34 +108,4 @@ namespace Ramulator
     }
   }
 
-  void initialize_core_channel_latency() {
-    const int latency_pattern[5] = {20, 30, 60, 100, 130};
-
-    for (int core = 0; core < 8; ++core) {
-        for (int ch = 0; ch < 8; ++ch) {
-            int offset = std::abs(core - ch);
-            if (offset < 5) {
-                core_channel_latency_matrix[core][ch] = latency_pattern[offset];
-            } else {
-                // Mirror the pattern for symmetry beyond offset 4
-                int mirrored_offset = 8 - offset;
-                core_channel_latency_matrix[core][ch] = latency_pattern[mirrored_offset];
-            }
-        }
-    }
-
-
-
-    // Print the core-channel latency matrix
-    // std::cout << "Core-to-Channel Latency Matrix:\n";
-    // for (int core = 0; core < 8; ++core) {
-    //     std::cout << "Core " << core << ": ";
-    //     for (int ch = 0; ch < 8; ++ch) {
-    //         std::cout << std::setw(3) << core_channel_latency_matrix[core][ch] << " ";
-    //     }
-    //     std::cout << "\n";
-    // }
-    
-  }
-
 } // namespace Ramulator
\ No newline at end of file
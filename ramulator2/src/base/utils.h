@@ -9,36 +9,6 @@
 
 namespace Ramulator
 {
-  // // Core-channel latency matrix
-  // inline const std::vector<std::vector<size_t>> core_channel_latency_matrix = {
-  //     // Channels: 0      1      2      3      4      5      6      7
-  //     {50, 60, 80, 90, 10, 110, 120, 130}, // Core 0
-  //     {50, 60, 80, 90, 100, 110, 120, 130}, // Core 1
-  //     {80, 90, 50, 60, 10, 110, 120, 130}, // Core 2
-  //     {80, 90, 50, 60, 100, 110, 120, 130}, // Core 3
-  //     {100, 110, 120, 130, 50, 60, 80, 90}, // Core 4
-  //     {100, 110, 120, 130, 50, 60, 80, 90}, // Core 5
-  //     {120, 130, 100, 110, 80, 90, 50, 60}, // Core 6
-  //     {120, 130, 100, 110, 80, 90, 50, 60}, // Core 7
-  //     {60, 50, 90, 80, 110, 100, 130, 120}, // Core 8
-  //     {60, 50, 90, 80, 110, 100, 130, 120}, // Core 9
-  //     {90, 80, 60, 50, 130, 120, 110, 100}, // Core 10
-  //     {90, 80, 60, 50, 130, 120, 110, 100}, // Core 11
-  //     {110, 100, 130, 120, 60, 50, 90, 80}, // Core 12
-  //     {110, 100, 130, 120, 60, 50, 90, 80}, // Core 13
-  //     {130, 120, 110, 100, 90, 80, 60, 50}, // Core 14
-  //     {130, 120, 110, 100, 90, 80, 60, 50}  // Core 15
-  // };
-
-  // Core-to-Channel Latency Matrix (filled dynamically)
-  inline int core_channel_latency_matrix[8][8];
-
-  // Min-latency channel for each core (precomputed)
-  inline int min_latency_channel[8];
-
-  // Fills the latency matrix and min-latency table
-  void initialize_core_channel_latency();
-
   // Global data structure (Page Table)
   inline std::unordered_map<size_t, size_t> page_table;
 
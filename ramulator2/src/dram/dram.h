@@ -5,6 +5,8 @@
 #include <vector>
 #include <map>
 #include <functional>
+#include <limits>
+#include <algorithm>
 
 #include "base/base.h"
 #include "dram/spec.h"
@@ -36,8 +38,64 @@ class IDRAM : public Clocked<IDRAM> {
     SpecDef m_requests;                                     // The definition of all requests supported
     SpecLUT<Command_t> m_request_translations{m_requests};  // A LUT of the final DRAM commands needed by every request
 
-    // TODO: make this a priority queue
-    std::vector<FutureAction> m_future_actions;  // A vector of requests that requires future state changes
+  /************************************************
+   *                Future Actions
+   ***********************************************/
+  private:
+    struct FutureActionLater {
+      bool operator()(const FutureAction& a, const FutureAction& b) const {
+        return a.clk > b.clk || (a.clk == b.clk && a.seq < b.seq);
+      };
+    };
+    std::vector<FutureAction> m_future_actions;   // A min-heap (on clk) of the commands that require future state changes
+    uint64_t m_future_action_seq = 0;
+
+  public:
+    /**
+     * @brief     Schedules handle_future_action(command, addr_vec) at cycle clk.
+     * @details
+     * Actions scheduled at or before the current cycle are never handled.
+     * 
+     */
+    void schedule_future_action(Command_t command, const AddrVec_t& addr_vec, Clk_t clk) {
+      m_future_actions.push_back({command, addr_vec, clk, m_future_action_seq++});
+      std::push_heap(m_future_actions.begin(), m_future_actions.end(), FutureActionLater());
+    };
+
+    /**
+     * @brief     Handles the future actions due at the current cycle. Called by the implementations every tick.
+     * 
+     */
+    void handle_due_future_actions() {
+      while (!m_future_actions.empty() && m_future_actions.front().clk <= m_clk) {
+        std::pop_heap(m_future_actions.begin(), m_future_actions.end(), FutureActionLater());
+        FutureAction future_action = std::move(m_future_actions.back());
+        m_future_actions.pop_back();
+        if (future_action.clk == m_clk) {
+          handle_future_action(future_action.cmd, future_action.addr_vec);
+        }
+      }
+    };
+
+    /**
+     * @brief     Returns the cycle of the next pending future action, or the maximum Clk_t if there is none.
+     * 
+     */
+    Clk_t get_next_future_action_clk() {
+      // Actions due at or before the current cycle were either handled or will never be
+      while (!m_future_actions.empty() && m_future_actions.front().clk <= m_clk) {
+        std::pop_heap(m_future_actions.begin(), m_future_actions.end(), FutureActionLater());
+        m_future_actions.pop_back();
+      }
+      return m_future_actions.empty() ? std::numeric_limits<Clk_t>::max() : m_future_actions.front().clk;
+    };
+
+  protected:
+    /**
+     * @brief     Applies the state changes of a future action scheduled with schedule_future_action().
+     * 
+     */
+    virtual void handle_future_action(int command, const AddrVec_t& addr_vec) {};
 
   /************************************************
    *                Node States
@@ -108,6 +166,42 @@ class IDRAM : public Clocked<IDRAM> {
      */
     virtual bool check_ready(int command, const AddrVec_t& addr_vec) = 0;
 
+    /**
+     * @brief     Returns the earliest clock cycle at which the device can accept the given command.
+     * @details
+     * check_ready(command, addr_vec) is equivalent to comparing the current clock cycle against this value,
+     * which stays valid for as long as get_state_version(addr_vec) does not change.
+     * 
+     */
+    virtual Clk_t get_ready_clk(int command, const AddrVec_t& addr_vec) = 0;
+
+    /**
+     * @brief     Returns the version of the state and timing information of the channel of the given address.
+     * @details
+     * The version changes whenever a command or a future action updates the channel. The results of get_preq_command()
+     * and get_ready_clk() for an address can be cached for as long as the version of its channel stays the same.
+     * 
+     */
+    virtual uint64_t get_state_version(const AddrVec_t& addr_vec) = 0;
+
+    /**
+     * @brief     Returns the current clock cycle of the device.
+     * 
+     */
+    Clk_t get_clk() const { return m_clk; };
+
+    /**
+     * @brief     Ticks before the next pending future action, which are otherwise no-ops for all device models.
+     * 
+     */
+    Clk_t get_num_idle_ticks() override {
+      Clk_t next_clk = get_next_future_action_clk();
+      if (next_clk == std::numeric_limits<Clk_t>::max()) {
+        return next_clk;
+      }
+      return next_clk - m_clk - 1;
+    };
+
     /**
      * @brief     Checks whether the command will result in a rowbuffer hit
      * @details
@@ -174,6 +174,16 @@ class DDR3 : public IDRAM, public Implementation {
       return m_channels[channel_id]->check_ready(command, addr_vec, m_clk);
     };
 
+    Clk_t get_ready_clk(int command, const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->get_ready_clk(command, addr_vec);
+    };
+
+    uint64_t get_state_version(const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->m_version;
+    };
+
     bool check_rowbuffer_hit(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
       return m_channels[channel_id]->check_rowbuffer_hit(command, addr_vec, m_clk);
@@ -225,13 +225,7 @@ class DDR5RVRR : public IDRAM, public Implementation {
       m_clk++;
 
       // Check if there is any future action at this cycle
-      for (int i = m_future_actions.size() - 1; i >= 0; i--) {
-        auto& future_action = m_future_actions[i];
-        if (future_action.clk == m_clk) {
-          handle_future_action(future_action.cmd, future_action.addr_vec);
-          m_future_actions.erase(m_future_actions.begin() + i);
-        }
-      }
+      handle_due_future_actions();
     };
 
     void init() override {
@@ -263,31 +257,31 @@ class DDR5RVRR : public IDRAM, public Implementation {
     void check_future_action(int command, const AddrVec_t& addr_vec) {
       switch (command) {
         case m_commands("REFab"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRFC1") - 1});
+          schedule_future_action(command, addr_vec, m_clk + m_timing_vals("nRFC1") - 1);
           break;
         case m_commands("REFsb"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRFCsb") - 1});
+          schedule_future_action(command, addr_vec, m_clk + m_timing_vals("nRFCsb") - 1);
           break;
         case m_commands("RFMab"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRFM1") - 1});
+          schedule_future_action(command, addr_vec, m_clk + m_timing_vals("nRFM1") - 1);
           break;
         case m_commands("RFMsb"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRFMsb") - 1});
+          schedule_future_action(command, addr_vec, m_clk + m_timing_vals("nRFMsb") - 1);
           break;
         case m_commands("DRFMab"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nDRFMab") - 1});
+          schedule_future_action(command, addr_vec, m_clk + m_timing_vals("nDRFMab") - 1);
           break;
         case m_commands("DRFMsb"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nDRFMsb") - 1});
+          schedule_future_action(command, addr_vec, m_clk + m_timing_vals("nDRFMsb") - 1);
           break;
         case m_commands("RRFMsb"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRRFMsb") - 1});
+          schedule_future_action(command, addr_vec, m_clk + m_timing_vals("nRRFMsb") - 1);
           break;
         case m_commands("VRR"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nVRR") - 1});
+          schedule_future_action(command, addr_vec, m_clk + m_timing_vals("nVRR") - 1);
           break;
         case m_commands("RVRR"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRVRR") - 1});
+          schedule_future_action(command, addr_vec, m_clk + m_timing_vals("nRVRR") - 1);
           break;
         default:
           // Other commands do not require future actions
@@ -295,7 +289,7 @@ class DDR5RVRR : public IDRAM, public Implementation {
       }
     }
 
-    void handle_future_action(int command, const AddrVec_t& addr_vec) {
+    void handle_future_action(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
       switch (command) {
         case m_commands("REFab"):
@@ -350,6 +344,16 @@ class DDR5RVRR : public IDRAM, public Implementation {
       return m_channels[channel_id]->check_ready(command, addr_vec, m_clk);
     };
 
+    Clk_t get_ready_clk(int command, const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->get_ready_clk(command, addr_vec);
+    };
+
+    uint64_t get_state_version(const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->m_version;
+    };
+
     bool check_rowbuffer_hit(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
       return m_channels[channel_id]->check_rowbuffer_hit(command, addr_vec, m_clk);
@@ -1,5 +1,6 @@
 #include "dram/dram.h"
 #include "dram/lambdas.h"
+#include "dram/timing_state.h"
 
 namespace Ramulator {
 
@@ -176,6 +177,9 @@ class DDR5 : public IDRAM, public Implementation {
       Node(DDR5* dram, Node* parent, int level, int id) : DRAMNodeBase<DDR5>(dram, parent, level, id) {};
     };
     std::vector<Node*> m_channels;
+
+    bool m_flat_timing = true;                  // Keep the timing information in m_timing_state instead of the nodes
+    DRAMTimingState<DDR5> m_timing_state;
     
     FuncMatrix<ActionFunc_t<Node>>  m_actions;
     FuncMatrix<PreqFunc_t<Node>>    m_preqs;
@@ -199,13 +203,7 @@ class DDR5 : public IDRAM, public Implementation {
       m_clk++;
 
       // Check if there is any future action at this cycle
-      for (int i = m_future_actions.size() - 1; i >= 0; i--) {
-        auto& future_action = m_future_actions[i];
-        if (future_action.clk == m_clk) {
-          handle_future_action(future_action.cmd, future_action.addr_vec);
-          m_future_actions.erase(m_future_actions.begin() + i);
-        }
-      }
+      handle_due_future_actions();
     };
 
     void init() override {
@@ -220,11 +218,20 @@ class DDR5 : public IDRAM, public Implementation {
       set_powers();
       
       create_nodes();
+
+      m_flat_timing = param<bool>("flat_timing").desc("Keep the timing state in flat per-level arrays instead of the node tree.").default_val(true);
+      if (m_flat_timing) {
+        m_timing_state.init(this);
+      }
     };
 
     void issue_command(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
-      m_channels[channel_id]->update_timing(command, addr_vec, m_clk);
+      if (m_flat_timing) {
+        m_timing_state.update_timing(command, addr_vec, m_clk);
+      } else {
+        m_channels[channel_id]->update_timing(command, addr_vec, m_clk);
+      }
       m_channels[channel_id]->update_powers(command, addr_vec, m_clk);
       m_channels[channel_id]->update_states(command, addr_vec, m_clk);
     
@@ -235,22 +242,22 @@ class DDR5 : public IDRAM, public Implementation {
     void check_future_action(int command, const AddrVec_t& addr_vec) {
       switch (command) {
         case m_commands("REFab"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRFC1") - 1});
+          schedule_future_action(command, addr_vec, m_clk + m_timing_vals("nRFC1") - 1);
           break;
         case m_commands("REFsb"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRFCsb") - 1});
+          schedule_future_action(command, addr_vec, m_clk + m_timing_vals("nRFCsb") - 1);
           break;
         case m_commands("RFMab"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRFM1") - 1});
+          schedule_future_action(command, addr_vec, m_clk + m_timing_vals("nRFM1") - 1);
           break;
         case m_commands("RFMsb"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRFMsb") - 1});
+          schedule_future_action(command, addr_vec, m_clk + m_timing_vals("nRFMsb") - 1);
           break;
         case m_commands("DRFMab"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nDRFMab") - 1});
+          schedule_future_action(command, addr_vec, m_clk + m_timing_vals("nDRFMab") - 1);
           break;
         case m_commands("DRFMsb"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nDRFMsb") - 1});
+          schedule_future_action(command, addr_vec, m_clk + m_timing_vals("nDRFMsb") - 1);
           break;
         default:
           // Other commands do not require future actions
@@ -258,7 +265,7 @@ class DDR5 : public IDRAM, public Implementation {
       }
     }
 
-    void handle_future_action(int command, const AddrVec_t& addr_vec) {
+    void handle_future_action(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
       switch (command) {
         case m_commands("REFab"):
@@ -297,10 +304,26 @@ class DDR5 : public IDRAM, public Implementation {
     };
 
     bool check_ready(int command, const AddrVec_t& addr_vec) override {
+      if (m_flat_timing) {
+        return m_timing_state.check_ready(command, addr_vec, m_clk);
+      }
       int channel_id = addr_vec[m_levels["channel"]];
       return m_channels[channel_id]->check_ready(command, addr_vec, m_clk);
     };
 
+    Clk_t get_ready_clk(int command, const AddrVec_t& addr_vec) override {
+      if (m_flat_timing) {
+        return m_timing_state.get_ready_clk(command, addr_vec);
+      }
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->get_ready_clk(command, addr_vec);
+    };
+
+    uint64_t get_state_version(const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->m_version;
+    };
+
     bool check_rowbuffer_hit(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
       return m_channels[channel_id]->check_rowbuffer_hit(command, addr_vec, m_clk);
@@ -1,5 +1,6 @@
 #include "dram/dram.h"
 #include "dram/lambdas.h"
+#include "dram/timing_state.h"
 
 namespace Ramulator {
 
@@ -120,6 +121,9 @@ class HBM3 : public IDRAM, public Implementation {
       Node(HBM3* dram, Node* parent, int level, int id) : DRAMNodeBase<HBM3>(dram, parent, level, id) {};
     };
     std::vector<Node*> m_channels;
+
+    bool m_flat_timing = true;                  // Keep the timing information in m_timing_state instead of the nodes
+    DRAMTimingState<HBM3> m_timing_state;
     
     FuncMatrix<ActionFunc_t<Node>>  m_actions;
     FuncMatrix<PreqFunc_t<Node>>    m_preqs;
@@ -143,11 +147,20 @@ class HBM3 : public IDRAM, public Implementation {
       set_rowopens();
       
       create_nodes();
+
+      m_flat_timing = param<bool>("flat_timing").desc("Keep the timing state in flat per-level arrays instead of the node tree.").default_val(true);
+      if (m_flat_timing) {
+        m_timing_state.init(this);
+      }
     };
 
     void issue_command(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
-      m_channels[channel_id]->update_timing(command, addr_vec, m_clk);
+      if (m_flat_timing) {
+        m_timing_state.update_timing(command, addr_vec, m_clk);
+      } else {
+        m_channels[channel_id]->update_timing(command, addr_vec, m_clk);
+      }
       m_channels[channel_id]->update_states(command, addr_vec, m_clk);
     };
 
@@ -157,10 +170,26 @@ class HBM3 : public IDRAM, public Implementation {
     };
 
     bool check_ready(int command, const AddrVec_t& addr_vec) override {
+      if (m_flat_timing) {
+        return m_timing_state.check_ready(command, addr_vec, m_clk);
+      }
       int channel_id = addr_vec[m_levels["channel"]];
       return m_channels[channel_id]->check_ready(command, addr_vec, m_clk);
     };
 
+    Clk_t get_ready_clk(int command, const AddrVec_t& addr_vec) override {
+      if (m_flat_timing) {
+        return m_timing_state.get_ready_clk(command, addr_vec);
+      }
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->get_ready_clk(command, addr_vec);
+    };
+
+    uint64_t get_state_version(const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->m_version;
+    };
+
     bool check_rowbuffer_hit(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
       return m_channels[channel_id]->check_rowbuffer_hit(command, addr_vec, m_clk);
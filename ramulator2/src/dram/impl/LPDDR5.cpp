@@ -173,6 +173,18 @@ class LPDDR5 : public IDRAM, public Implementation {
       return m_channels[channel_id]->check_ready(command, addr_vec, m_clk);
     };
 
+    Clk_t get_ready_clk(int command, const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->get_ready_clk(command, addr_vec);
+    };
+
+    uint64_t get_state_version(const AddrVec_t& addr_vec) override {
+      // RD16/WR16 prerequisites also depend on the WCK2CK sync deadline, so the version has to advance with the clock too
+      // (both terms only ever grow, so the sum still identifies the state)
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->m_version + m_clk;
+    };
+
     bool check_rowbuffer_hit(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
       return m_channels[channel_id]->check_rowbuffer_hit(command, addr_vec, m_clk);
@@ -2,8 +2,9 @@
 #define RAMULATOR_DRAM_NODE_H
 
 #include <vector>
-#include <map>
 #include <deque>
+#include <utility>
+#include <algorithm>
 #include <functional>
 #include <concepts>
 
@@ -26,6 +27,44 @@ concept IsDRAMSpec = requires(T t) {
 // };
 
 
+/**
+ * @brief     The state of the rows of a bank-ish node, as a flat array of (row, state) pairs.
+ * @details
+ * Only the opened rows are tracked, which is (almost always) a single one, so a linear search over a small array
+ * that keeps its capacity across clear() beats the node allocations of a std::map.
+ * 
+ */
+class RowStateTable {
+  public:
+    using RowId_t = int;
+    using RowState_t = int;
+    using Entry_t = std::pair<RowId_t, RowState_t>;
+    using iterator = std::vector<Entry_t>::iterator;
+
+  private:
+    std::vector<Entry_t> m_entries;
+
+  public:
+    iterator begin() { return m_entries.begin(); };
+    iterator end() { return m_entries.end(); };
+    size_t size() const { return m_entries.size(); };
+    void clear() { m_entries.clear(); };
+
+    iterator find(RowId_t row) {
+      return std::find_if(m_entries.begin(), m_entries.end(), [row](const Entry_t& e) { return e.first == row; });
+    };
+
+    RowState_t& operator[](RowId_t row) {
+      auto it = find(row);
+      if (it != m_entries.end()) {
+        return it->second;
+      }
+      m_entries.push_back({row, RowState_t()});
+      return m_entries.back().second;
+    };
+};
+
+
 /**
  * @brief     CRTP-ish (?) base class of a DRAM Device Node
  * 
@@ -44,12 +83,14 @@ struct DRAMNodeBase {
 
     int m_state = -1;      // The state of the node
 
+    uint64_t m_version = 0;   // Bumped on every state or timing update that reaches this node, if I am a channel node
+
     std::vector<Clk_t> m_cmd_ready_clk;             // The next cycle that each command can be issued again at this level
     std::vector<std::deque<Clk_t>> m_cmd_history;   // Issue-history of each command at this level
 
     using RowId_t = int;
     using RowState_t = int;
-    std::map<RowId_t, RowState_t> m_row_state;  // The state of the rows, if I am a bank-ish node
+    RowStateTable m_row_state;  // The state of the rows, if I am a bank-ish node
 
     DRAMNodeBase(T* spec, NodeType* parent, int level, int id):
     m_spec(spec), m_parent_node(parent), m_level(level), m_node_id(id) {
@@ -89,6 +130,9 @@ struct DRAMNodeBase {
     };
 
     void update_states(int command, const AddrVec_t& addr_vec, Clk_t clk) {
+      if (m_parent_node == nullptr) {
+        m_version++;
+      }
       int child_id = addr_vec[m_level+1];
       if (m_spec->m_actions[m_level][command]) {
         // update the state machine at this level
@@ -132,6 +176,10 @@ struct DRAMNodeBase {
     };
 
     void update_timing(int command, const AddrVec_t& addr_vec, Clk_t clk) {
+      if (m_parent_node == nullptr) {
+        m_version++;
+      }
+
       /************************************************
        *         Update Sibling Node Timing
        ***********************************************/
@@ -231,6 +279,28 @@ struct DRAMNodeBase {
       }
     };
 
+    /**
+     * @brief    Returns the earliest clock cycle at which check_ready() passes, given the current timing information.
+     *
+     */
+    Clk_t get_ready_clk(int command, const AddrVec_t& addr_vec) {
+      Clk_t ready_clk = m_cmd_ready_clk[command];
+
+      int child_id = addr_vec[m_level+1];
+      if (m_level == m_spec->m_command_scopes[command] || !m_child_nodes.size()) {
+        return ready_clk;
+      }
+
+      if (child_id == -1) {
+        for (auto child : m_child_nodes) {
+          ready_clk = std::max(ready_clk, child->get_ready_clk(command, addr_vec));
+        }
+      } else {
+        ready_clk = std::max(ready_clk, m_child_nodes[child_id]->get_ready_clk(command, addr_vec));
+      }
+      return ready_clk;
+    };
+
     bool check_rowbuffer_hit(int command, const AddrVec_t& addr_vec, Clk_t m_clk) {
       // TODO: Optimize this by just checking the bank-levels? Have a dedicated bank structure?
       int child_id = addr_vec[m_level+1];
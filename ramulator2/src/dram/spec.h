@@ -41,6 +41,7 @@ struct FutureAction {
   Command_t cmd;
   AddrVec_t addr_vec;
   Clk_t clk;
+  uint64_t seq = 0;   // Order of scheduling, actions due at the same cycle are handled latest first
 };
 
 // Timing Constraint
@@ -0,0 +1,236 @@
+#ifndef RAMULATOR_DRAM_TIMING_STATE_H
+#define RAMULATOR_DRAM_TIMING_STATE_H
+
+#include <array>
+#include <vector>
+#include <algorithm>
+
+#include "base/type.h"
+#include "dram/node.h"
+
+namespace Ramulator {
+
+/**
+ * @brief     Flat timing state of a DRAM device, an alternative to the timing information kept in the node tree.
+ * @details
+ * Instead of walking the node tree, the earliest issue cycle of every command and the issue history needed by the
+ * windowed constraints (e.g., nFAW) are kept in one contiguous array per level, with the nodes of a level numbered
+ * by their address (e.g., the bank index is (channel * #ranks + rank) * #banks + bank). The per-node command
+ * history is a fixed-size ring buffer per command. The shape of the tables (number of node levels and commands) is
+ * fixed at compile time per standard, the timing constraints are flattened into one array per (level, command) at
+ * initialization, as their values depend on the presets and the configuration.
+ *
+ * update_timing() visits exactly the nodes that DRAMNodeBase::update_timing() updates, so both produce the same
+ * ready cycles. It stops below the deepest level at which the command constrains anything.
+ *
+ */
+template<IsDRAMSpec T>
+class DRAMTimingState {
+  private:
+    static constexpr int NumLevels = T::m_levels["row"];      // Levels that have nodes (channel ... bank)
+    static constexpr int NumCmds = T::m_commands.size();
+
+    struct Constraint {
+      int cmd;
+      int val;
+      int window;
+    };
+
+    struct ConstraintRange {
+      int begin = 0;
+      int end = 0;
+    };
+
+    std::array<int, NumLevels> m_count{};         // Number of children of a node at the previous level
+    std::array<int, NumLevels> m_num_nodes{};     // Number of nodes at each level in the whole device
+    int m_num_node_levels = 0;                    // Levels are cut at the first level with no nodes
+
+    std::array<int, NumCmds> m_scope{};           // Level check_ready() stops at
+    std::array<int, NumCmds> m_last_level{};      // Deepest level that update_timing() has to visit
+
+    std::vector<Constraint> m_constraints;
+    std::array<std::array<ConstraintRange, NumCmds>, NumLevels> m_own{};
+    std::array<std::array<ConstraintRange, NumCmds>, NumLevels> m_sibling{};
+
+    std::array<std::vector<Clk_t>, NumLevels> m_ready_clk;    // [node * NumCmds + cmd]
+
+    std::array<std::array<int, NumCmds>, NumLevels> m_window{};           // History length of each command
+    std::array<std::array<int, NumCmds>, NumLevels> m_history_offset{};   // Offset of the ring in a node's history
+    std::array<int, NumLevels> m_history_stride{};
+    std::array<std::vector<Clk_t>, NumLevels> m_history;      // [node * stride + offset + slot]
+    std::array<std::vector<int>, NumLevels> m_history_head;   // [node * NumCmds + cmd], slot of the latest issue
+
+    std::vector<int> m_targets;
+    std::vector<int> m_next_targets;
+
+  public:
+    void init(T* spec) {
+      m_num_node_levels = 0;
+      for (int level = 0; level < NumLevels; level++) {
+        int count = spec->m_organization.count[level];
+        if (count <= 0) {
+          break;
+        }
+        m_count[level] = count;
+        m_num_nodes[level] = (level == 0) ? count : m_num_nodes[level - 1] * count;
+        m_num_node_levels++;
+      }
+
+      m_constraints.clear();
+      for (int level = 0; level < m_num_node_levels; level++) {
+        for (int cmd = 0; cmd < NumCmds; cmd++) {
+          const auto& cons = spec->m_timing_cons[level][cmd];
+          for (bool sibling : {false, true}) {
+            ConstraintRange& range = sibling ? m_sibling[level][cmd] : m_own[level][cmd];
+            range.begin = m_constraints.size();
+            for (const auto& t : cons) {
+              if (t.sibling == sibling && t.window > 0) {
+                m_constraints.push_back({t.cmd, t.val, t.window});
+              }
+            }
+            range.end = m_constraints.size();
+          }
+        }
+      }
+
+      for (int cmd = 0; cmd < NumCmds; cmd++) {
+        m_scope[cmd] = std::min(int(T::m_command_scopes[cmd]), m_num_node_levels - 1);
+        m_last_level[cmd] = 0;
+        for (int level = 0; level < m_num_node_levels; level++) {
+          if (m_own[level][cmd].begin != m_own[level][cmd].end || m_sibling[level][cmd].begin != m_sibling[level][cmd].end) {
+            m_last_level[cmd] = level;
+          }
+        }
+      }
+
+      for (int level = 0; level < m_num_node_levels; level++) {
+        m_ready_clk[level].assign(size_t(m_num_nodes[level]) * NumCmds, -1);
+
+        int stride = 0;
+        for (int cmd = 0; cmd < NumCmds; cmd++) {
+          int window = 0;
+          for (int i = m_own[level][cmd].begin; i < m_own[level][cmd].end; i++) {
+            window = std::max(window, m_constraints[i].window);
+          }
+          m_window[level][cmd] = window;
+          m_history_offset[level][cmd] = stride;
+          stride += window;
+        }
+        m_history_stride[level] = stride;
+        m_history[level].assign(size_t(m_num_nodes[level]) * stride, -1);
+        m_history_head[level].assign(size_t(m_num_nodes[level]) * NumCmds, 0);
+      }
+    };
+
+    void update_timing(int command, const AddrVec_t& addr_vec, Clk_t clk) {
+      int channel_id = addr_vec[0];
+      update_target(0, channel_id, command, clk);
+
+      m_targets.clear();
+      m_targets.push_back(channel_id);
+      for (int level = 1; level <= m_last_level[command]; level++) {
+        int count = m_count[level];
+        int child_id = addr_vec[level];
+        bool has_sibling = m_sibling[level][command].begin != m_sibling[level][command].end;
+
+        m_next_targets.clear();
+        for (int parent : m_targets) {
+          int first = parent * count;
+          if (child_id == -1) {
+            for (int i = 0; i < count; i++) {
+              update_target(level, first + i, command, clk);
+              m_next_targets.push_back(first + i);
+            }
+          } else {
+            if (has_sibling) {
+              for (int i = 0; i < count; i++) {
+                if (i != child_id) {
+                  update_sibling(level, first + i, command, clk);
+                }
+              }
+            }
+            update_target(level, first + child_id, command, clk);
+            m_next_targets.push_back(first + child_id);
+          }
+        }
+        std::swap(m_targets, m_next_targets);
+      }
+    };
+
+    Clk_t get_ready_clk(int command, const AddrVec_t& addr_vec) const {
+      int node = addr_vec[0];
+      Clk_t ready_clk = m_ready_clk[0][node * NumCmds + command];
+      for (int level = 1; level <= m_scope[command]; level++) {
+        int child_id = addr_vec[level];
+        if (child_id == -1) {
+          return std::max(ready_clk, get_subtree_ready_clk(level, node, command, addr_vec));
+        }
+        node = node * m_count[level] + child_id;
+        ready_clk = std::max(ready_clk, m_ready_clk[level][node * NumCmds + command]);
+      }
+      return ready_clk;
+    };
+
+    bool check_ready(int command, const AddrVec_t& addr_vec, Clk_t clk) const {
+      return clk >= get_ready_clk(command, addr_vec);
+    };
+
+  private:
+    void update_target(int level, int node, int command, Clk_t clk) {
+      int window = m_window[level][command];
+      const Clk_t* history = nullptr;
+      int head = 0;
+      if (window) {
+        Clk_t* ring = &m_history[level][size_t(node) * m_history_stride[level] + m_history_offset[level][command]];
+        int& latest = m_history_head[level][node * NumCmds + command];
+        latest = (latest + 1 == window) ? 0 : latest + 1;
+        ring[latest] = clk;
+        history = ring;
+        head = latest;
+      }
+
+      Clk_t* ready_clk = &m_ready_clk[level][node * NumCmds];
+      const ConstraintRange& range = m_own[level][command];
+      for (int i = range.begin; i < range.end; i++) {
+        const Constraint& t = m_constraints[i];
+        // The (t.window)-th latest issue of the command
+        int slot = head - (t.window - 1);
+        slot += (slot < 0) ? window : 0;
+        Clk_t past = history[slot];
+        if (past < 0) {
+          // not enough history
+          continue;
+        }
+        ready_clk[t.cmd] = std::max(ready_clk[t.cmd], past + t.val);
+      }
+    };
+
+    void update_sibling(int level, int node, int command, Clk_t clk) {
+      Clk_t* ready_clk = &m_ready_clk[level][node * NumCmds];
+      const ConstraintRange& range = m_sibling[level][command];
+      for (int i = range.begin; i < range.end; i++) {
+        const Constraint& t = m_constraints[i];
+        ready_clk[t.cmd] = std::max(ready_clk[t.cmd], clk + t.val);
+      }
+    };
+
+    Clk_t get_subtree_ready_clk(int level, int parent, int command, const AddrVec_t& addr_vec) const {
+      Clk_t ready_clk = -1;
+      int count = m_count[level];
+      int child_id = addr_vec[level];
+      int begin = (child_id == -1) ? 0 : child_id;
+      int end = (child_id == -1) ? count : child_id + 1;
+      for (int i = begin; i < end; i++) {
+        int node = parent * count + i;
+        ready_clk = std::max(ready_clk, m_ready_clk[level][node * NumCmds + command]);
+        if (level < m_scope[command]) {
+          ready_clk = std::max(ready_clk, get_subtree_ready_clk(level + 1, node, command, addr_vec));
+        }
+      }
+      return ready_clk;
+    };
+};
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_DRAM_TIMING_STATE_H
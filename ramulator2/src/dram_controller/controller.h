@@ -44,6 +44,20 @@ class IDRAMController : public Clocked<IDRAMController> {
      */
     virtual bool priority_send(Request& req) = 0;
 
+    /**
+     * @brief       Send a low-priority request (e.g., a page copy of a migration) that is only scheduled when neither
+     *              the read nor the write buffer has a ready request.
+     * 
+     * @return   false      Failed (e.g., buffer full), or the controller has no low-priority buffer.
+     */
+    virtual bool copy_send(Request& req) { return false; };
+
+    /**
+     * @brief       Whether the controller has a low-priority buffer for copy_send().
+     * 
+     */
+    virtual bool accepts_copy_requests() { return false; };
+
     /**
      * @brief       Ticks the memory controller.
      * 
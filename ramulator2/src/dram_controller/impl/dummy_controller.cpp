@@ -1,3 +1,5 @@
+#include <limits>
+
 #include "dram_controller/controller.h"
 
 namespace Ramulator {
@@ -28,6 +30,14 @@ class DummyController final : public IDRAMController, public Implementation {
       return;
     }
 
+    Clk_t get_num_idle_ticks() override {
+      return std::numeric_limits<Clk_t>::max();
+    };
+
+    void skip_idle_ticks(Clk_t n) override {
+      return;
+    };
+
 };
 
 }   // namespace Ramulator
\ No newline at end of file
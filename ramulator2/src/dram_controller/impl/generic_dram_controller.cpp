@@ -15,6 +15,7 @@ namespace Ramulator
     ReqBuffer m_priority_buffer; // Buffer for high-priority requests (e.g., maintenance like refresh).
     ReqBuffer m_read_buffer;     // Read request buffer
     ReqBuffer m_write_buffer;    // Write request buffer
+    ReqBuffer m_copy_buffer;     // Buffer for low-priority copies (e.g., page migrations), served when no read or write is ready
 
     int m_bank_addr_idx = -1;
 
@@ -74,7 +75,11 @@ namespace Ramulator
 
     void setup(IFrontEnd *frontend, IMemorySystem *memory_system) override
     {
-      m_dram = memory_system->get_ifce<IDRAM>();
+      // The memory system may have given this channel a device model of its own
+      if (m_dram == nullptr)
+      {
+        m_dram = memory_system->get_ifce<IDRAM>();
+      }
       m_bank_addr_idx = m_dram->m_levels("bank");
       m_priority_buffer.max_size = 512 * 3 + 32;
 
@@ -200,6 +205,17 @@ namespace Ramulator
       return is_success;
     }
 
+    bool copy_send(Request &req) override
+    {
+      req.final_command = m_dram->m_request_translations(req.type_id);
+      return m_copy_buffer.enqueue(req);
+    }
+
+    bool accepts_copy_requests() override
+    {
+      return true;
+    }
+
     void tick() override
     {
       m_clk++;
@@ -264,6 +280,43 @@ namespace Ramulator
       }
     };
 
+    /**
+     * @brief    Number of upcoming ticks that can only update the queue length statistics
+     * @details
+     * With all request buffers empty (and no plugin or row policy that acts on idle cycles), a tick only accumulates
+     * the queue length statistics until either the first pending read departs or the refresh manager issues a refresh.
+     *
+     */
+    Clk_t get_num_idle_ticks() override
+    {
+      if (m_active_buffer.size() || m_priority_buffer.size() || m_read_buffer.size() || m_write_buffer.size() ||
+          m_copy_buffer.size() || m_plugins.size() || m_rowpolicy->updates_when_idle())
+      {
+        return 0;
+      }
+
+      Clk_t num_idle_ticks = m_refresh->get_num_idle_ticks();
+      if (pending.size())
+      {
+        num_idle_ticks = std::min(num_idle_ticks, pending[0].depart - m_clk - 1);
+      }
+      return std::max(num_idle_ticks, (Clk_t)0);
+    };
+
+    void skip_idle_ticks(Clk_t n) override
+    {
+      if (n <= 0)
+      {
+        return;
+      }
+      m_clk += n;
+      s_queue_len += n * pending.size();
+      s_read_queue_len += n * pending.size();
+      m_refresh->skip_idle_ticks(n);
+      // Every idle tick queries the write mode with empty buffers, which settles after the first one
+      set_write_mode();
+    };
+
   private:
     /**
      * @brief    Helper function to check if a request is hitting an open row
@@ -352,8 +405,8 @@ namespace Ramulator
         auto &req = pending[0];
         if (req.depart <= m_clk)
         {
-          // Request received data from dram
-          if (req.depart - req.arrive > 1)
+          // Request received data from dram, requests from priority_send() and copy_send() have no arrival and are not counted
+          if (req.arrive != -1 && req.depart - req.arrive > 1)
           {
             // Check if this requests accesses the DRAM or is being forwarded.
             // TODO add the stats back
@@ -362,7 +415,6 @@ namespace Ramulator
             // {
             //   std::cout << "Request " << req.addr << " took " << req.depart - req.arrive << " cycles to complete.\n";
             // }
-            s_read_latency += 2*core_channel_latency_matrix[req.source_id][req.addr_vec[0]];
           }
 
           if (req.callback)
@@ -398,6 +450,16 @@ namespace Ramulator
       }
     };
 
+    /**
+     * @brief    Whether the best request of the buffer can be issued in this cycle.
+     *
+     */
+    bool has_ready_request(ReqBuffer &buffer)
+    {
+      auto req_it = m_scheduler->get_best_request(buffer);
+      return req_it != buffer.end() && m_dram->check_ready(req_it->command, req_it->addr_vec);
+    }
+
     /**
      * @brief    Helper function to find a request to schedule from the buffers.
      *
@@ -444,6 +506,16 @@ namespace Ramulator
             req_buffer = &buffer;
           }
         }
+
+        // 2.2.2    Copies only get the cycles in which no read or write is ready, so they never delay demand requests
+        if (!request_found && m_copy_buffer.size() != 0 && !has_ready_request(m_is_write_mode ? m_read_buffer : m_write_buffer))
+        {
+          if (req_it = m_scheduler->get_best_request(m_copy_buffer); req_it != m_copy_buffer.end())
+          {
+            request_found = m_dram->check_ready(req_it->command, req_it->addr_vec);
+            req_buffer = &m_copy_buffer;
+          }
+        }
       }
 
       // 2.3 If we find a request to schedule, we need to check if it will close an opened row in the active buffer.
@@ -56,6 +56,14 @@ class AllBankRefresh : public IRefreshManager, public Implementation {
       }
     };
 
+    Clk_t get_num_idle_ticks() override {
+      return m_next_refresh_cycle - m_clk - 1;
+    };
+
+    void skip_idle_ticks(Clk_t n) override {
+      m_clk += n;
+    };
+
 };
 
 }       // namespace Ramulator
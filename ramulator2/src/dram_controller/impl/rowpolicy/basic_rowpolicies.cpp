@@ -20,6 +20,8 @@ class OpenRowPolicy : public IRowPolicy, public Implementation {
       // OpenRowPolicy does not need to take any actions
     };
 
+    bool updates_when_idle() override { return false; };
+
 
 };
 
@@ -69,6 +71,8 @@ class ClosedRowPolicy : public IRowPolicy, public Implementation {
       register_stat(s_num_close_reqs).name("num_close_reqs");
     };
 
+    bool updates_when_idle() override { return false; };
+
     void update(bool request_found, ReqBuffer::iterator& req_it) override {
 
       if (!request_found)
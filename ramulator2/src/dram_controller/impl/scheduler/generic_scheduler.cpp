@@ -38,18 +38,36 @@ class FRFCFS : public IScheduler, public Implementation {
       } 
     }
 
+    /**
+     * @brief    Same choice as reducing the buffer with compare(): the oldest ready request, else the oldest request,
+     *           earliest in the buffer on ties.
+     * @details
+     * Both the prerequisite command and its readiness only change when a command or a future action updates the
+     * channel, so they are cached in the request together with the channel's state version, and the per-cycle work
+     * for a request whose channel has not changed is a comparison against the cycle its command becomes ready.
+     */
     ReqBuffer::iterator get_best_request(ReqBuffer& buffer) override {
       if (buffer.size() == 0) {
         return buffer.end();
       }
 
-      for (auto& req : buffer) {
-        req.command = m_dram->get_preq_command(req.final_command, req.addr_vec);
-      }
+      Clk_t clk = m_dram->get_clk();
+      auto candidate = buffer.end();
+      bool candidate_ready = false;
+      for (auto it = buffer.begin(); it != buffer.end(); it++) {
+        uint64_t version = m_dram->get_state_version(it->addr_vec);
+        if (it->preq_version != version) {
+          it->preq_command = m_dram->get_preq_command(it->final_command, it->addr_vec);
+          it->preq_ready_clk = m_dram->get_ready_clk(it->preq_command, it->addr_vec);
+          it->preq_version = version;
+        }
+        it->command = it->preq_command;
 
-      auto candidate = buffer.begin();
-      for (auto next = std::next(buffer.begin(), 1); next != buffer.end(); next++) {
-        candidate = compare(candidate, next);
+        bool ready = clk >= it->preq_ready_clk;
+        if (candidate == buffer.end() || (ready && !candidate_ready) || (ready == candidate_ready && it->arrive < candidate->arrive)) {
+          candidate = it;
+          candidate_ready = ready;
+        }
       }
       return candidate;
     }
@@ -14,6 +14,12 @@ class IRefreshManager {
 
   public:
     virtual void tick() = 0;
+
+    /**
+     * @brief    Number of upcoming ticks before the next refresh request is issued. 0 (the default) disables skipping.
+     */
+    virtual Clk_t get_num_idle_ticks() { return 0; };
+    virtual void skip_idle_ticks(Clk_t n) {};
 };
 
 }        // namespace Ramulator
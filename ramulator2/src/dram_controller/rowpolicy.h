@@ -16,6 +16,11 @@ class IRowPolicy {
 
   public:
     virtual void update(bool request_found, ReqBuffer::iterator& req_it) = 0;
+
+    /**
+     * @brief    Whether update(false, ...) can change state, i.e., whether an idle controller still has to call it every cycle.
+     */
+    virtual bool updates_when_idle() { return true; };
 };
 
 }        // namespace Ramulator
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
+#include "frontend/frontend.h"
+#include "base/config.h"
+#include "base/exception.h"
+#include "base/topology.h"
+#include "translation/translation.h"
+#include "frontend/impl/external_wrapper/sniper_wrapper.h"
+
+namespace Ramulator {
+
+
+class Sniper : public IFrontEnd, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IFrontEnd, Sniper, "Sniper", "Sniper frontend for online co-simulation.")
+
+  private:
+    ITranslation* m_translation = nullptr;
+
+  public:
+    void init() override {
+      // The translation is optional so that Sniper's own physical addresses can be used as-is
+      if (m_config["Translation"]) {
+        m_translation = create_child_ifce<ITranslation>();
+      }
+    };
+    void tick() override { };
+
+    bool receive_external_requests(int req_type_id, Addr_t addr, int source_id, std::function<void(Request&)> callback) override {
+      Request req(addr, req_type_id, source_id, callback);
+      if (m_translation) {
+        vpn_access_count[req.addr >> 12]++;
+        if (!m_translation->translate(req)) {
+          // Dropped by the translation, complete it right away so that the requester does not wait forever
+          if (req.type_id == Request::Type::Read) {
+            callback(req);
+          }
+          return true;
+        }
+      }
+      return m_memory_system->send(req);
+    }
+
+  private:
+    bool is_finished() override { return true; };
+};
+
+}        // namespace Ramulator
+
+
+struct ramulator2_sim {
+  Ramulator::IFrontEnd* frontend = nullptr;
+  Ramulator::IMemorySystem* memory_system = nullptr;
+  uint64_t clk = 0;
+  std::deque<uint64_t> completed;
+};
+
+extern "C" {
+
+ramulator2_sim_t* ramulator2_create(const char* config_path) {
+  try {
+    YAML::Node config = Ramulator::Config::parse_config_file(config_path, {});
+    Ramulator::numa_topology.init(config["Topology"]);
+
+    ramulator2_sim_t* sim = new ramulator2_sim_t;
+    sim->frontend = Ramulator::Factory::create_frontend(config);
+    sim->memory_system = Ramulator::Factory::create_memory_system(config);
+    sim->frontend->connect_memory_system(sim->memory_system);
+    sim->memory_system->connect_frontend(sim->frontend);
+    return sim;
+  } catch (const std::exception& e) {
+    spdlog::error("Failed to create Ramulator 2.0 from {}: {}", config_path, e.what());
+    return nullptr;
+  }
+}
+
+void ramulator2_destroy(ramulator2_sim_t* sim) {
+  sim->frontend->finalize();
+  sim->memory_system->finalize();
+  delete sim;
+}
+
+uint64_t ramulator2_get_tck_ps(ramulator2_sim_t* sim) {
+  // Memory systems without a clock period report -1
+  float tck_ns = sim->memory_system->get_tCK();
+  if (tck_ns <= 0) {
+    return 0;
+  }
+  return std::llround(tck_ns * 1000.0f);
+}
+
+uint64_t ramulator2_get_clk(ramulator2_sim_t* sim) {
+  return sim->clk;
+}
+
+int ramulator2_send(ramulator2_sim_t* sim, int is_write, uint64_t addr, int source_id, uint64_t tag) {
+  int type_id = is_write ? Ramulator::Request::Type::Write : Ramulator::Request::Type::Read;
+  auto callback = [sim, tag](Ramulator::Request&) { sim->completed.push_back(tag); };
+  return sim->frontend->receive_external_requests(type_id, addr, source_id, callback) ? 1 : 0;
+}
+
+void ramulator2_tick(ramulator2_sim_t* sim) {
+  sim->memory_system->tick();
+  sim->clk++;
+}
+
+uint64_t ramulator2_skip_idle(ramulator2_sim_t* sim, uint64_t max_cycles) {
+  Ramulator::Clk_t num_idle_ticks = sim->memory_system->get_num_idle_ticks();
+  uint64_t n = std::min<uint64_t>(std::max<Ramulator::Clk_t>(num_idle_ticks, 0), max_cycles);
+  if (n > 0) {
+    sim->memory_system->skip_idle_ticks(n);
+    sim->clk += n;
+  }
+  return n;
+}
+
+int ramulator2_pop_completed(ramulator2_sim_t* sim, uint64_t* tag) {
+  if (sim->completed.empty()) {
+    return 0;
+  }
+  *tag = sim->completed.front();
+  sim->completed.pop_front();
+  return 1;
+}
+
+}
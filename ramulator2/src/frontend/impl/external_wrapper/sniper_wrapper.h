@@ -0,0 +1,61 @@
+#ifndef     RAMULATOR_FRONTEND_EXTERNAL_WRAPPER_SNIPER_WRAPPER_H
+#define     RAMULATOR_FRONTEND_EXTERNAL_WRAPPER_SNIPER_WRAPPER_H
+
+#include <stdint.h>
+
+/**
+ * @brief    C interface for embedding Ramulator 2.0 in-process into Sniper.
+ *
+ * @details
+ * Sniper is built with the pre-C++11 std::string ABI and cannot share any standard library type with Ramulator,
+ * so everything crossing this boundary is plain data. The handle owns a frontend (which must be the "Sniper"
+ * frontend) and a memory system created from a regular Ramulator YAML configuration. The caller drives the
+ * memory system clock with ramulator2_tick() and collects completed reads with ramulator2_pop_completed().
+ *
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ramulator2_sim ramulator2_sim_t;
+
+/// Creates the frontend and memory system from the YAML file at config_path, returns NULL on error.
+ramulator2_sim_t* ramulator2_create(const char* config_path);
+
+/// Finalizes the simulation (printing all statistics) and frees the handle.
+void ramulator2_destroy(ramulator2_sim_t* sim);
+
+/// The memory system clock period (tCK) in picoseconds, 0 if the memory system does not report one.
+uint64_t ramulator2_get_tck_ps(ramulator2_sim_t* sim);
+
+/// Number of memory system cycles simulated so far.
+uint64_t ramulator2_get_clk(ramulator2_sim_t* sim);
+
+/**
+ * @brief    Tries to send a request to the memory system.
+ *
+ * @return   1 if the request was accepted, 0 if the caller should tick and retry.
+ *           Accepted reads are reported through ramulator2_pop_completed() with the given tag once served.
+ */
+int ramulator2_send(ramulator2_sim_t* sim, int is_write, uint64_t addr, int source_id, uint64_t tag);
+
+/// Advances the memory system by one cycle.
+void ramulator2_tick(ramulator2_sim_t* sim);
+
+/**
+ * @brief    Fast-forwards over at most max_cycles cycles in which the memory system would do nothing but count
+ *           (e.g., while all controllers are empty), with the same effect as ticking through them.
+ *
+ * @return   The number of cycles skipped, 0 if the next cycle may do work.
+ */
+uint64_t ramulator2_skip_idle(ramulator2_sim_t* sim, uint64_t max_cycles);
+
+/// Pops the tag of one completed read, returns 0 if there is none.
+int ramulator2_pop_completed(ramulator2_sim_t* sim, uint64_t* tag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // RAMULATOR_FRONTEND_EXTERNAL_WRAPPER_SNIPER_WRAPPER_H
@@ -0,0 +1,206 @@
+#include <filesystem>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "frontend/frontend.h"
+#include "frontend/impl/memory_trace/binary_trace.h"
+#include "base/exception.h"
+#include "translation/translation.h"
+
+namespace Ramulator
+{
+
+    namespace fs = std::filesystem;
+
+    class CustomTrace2Binary : public IFrontEnd, public Implementation
+    {
+        RAMULATOR_REGISTER_IMPLEMENTATION(IFrontEnd, CustomTrace2Binary, "CustomTrace2Binary", "Memory-mapped binary version of the CustomTrace2 trace.")
+
+    private:
+        int m_fd = -1;
+        void *m_map = nullptr;
+        size_t m_map_size = 0;
+
+        const BinaryTraceRecord *m_trace = nullptr; // Records inside the mapping
+        size_t m_trace_length = 0;
+        size_t m_curr_trace_idx = 0;
+
+        // Consumed parts of the mapping are dropped every m_release_records records so that the resident set stays bounded
+        size_t m_release_records = 0;
+        size_t m_released_until = 0;
+
+        Logger_t m_logger;
+        ITranslation *m_translation; // Translation module instance
+        uint64_t clk = 0;            // Current clock cycle
+        bool m_respect_timestamps = false;
+
+    public:
+        void init() override
+        {
+            std::string trace_path_str = param<std::string>("path").desc("Path to the binary trace file.").required();
+            m_clock_ratio = param<uint>("clock_ratio").required();
+            m_respect_timestamps = param<bool>("respect_timestamps").desc("Issue each record no earlier than its clk instead of replaying the records back to back.").default_val(false);
+            size_t window_MB = param<size_t>("resident_window_MB").desc("Amount of consumed trace (in MB) kept mapped before it is released.").default_val(64);
+            m_release_records = std::max<size_t>((window_MB << 20) / sizeof(BinaryTraceRecord), 1);
+
+            m_logger = Logging::create_logger("CustomTrace2Binary");
+            m_logger->info("Mapping trace file {} ...", trace_path_str);
+            init_trace(trace_path_str);
+            m_logger->info("Mapped {} records.", m_trace_length);
+
+            m_translation = create_child_ifce<ITranslation>(); // Initialize translation module
+        };
+
+        ~CustomTrace2Binary()
+        {
+            if (m_map != nullptr)
+            {
+                munmap(m_map, m_map_size);
+            }
+            if (m_fd != -1)
+            {
+                close(m_fd);
+            }
+        };
+
+        void tick() override
+        {
+            m_translation->tick();
+
+            const BinaryTraceRecord &t = m_trace[m_curr_trace_idx];
+
+            // Wait if trace is for future clk
+            if (m_respect_timestamps ? (t.clk > clk) : (t.clk < clk))
+            {
+                clk++;
+                return;
+            }
+
+            Request req(t.addr, t.type_id == Request::Type::Write ? Request::Type::Write : Request::Type::Read, t.source_id);
+            vpn_access_count[req.addr >> 12]++;
+
+            if (!m_translation->translate(req))
+            {
+                advance();
+                return; // Skip if translation fails
+            }
+
+            if (!m_memory_system->send(req))
+            {
+                return; // Stall if request not accepted
+            }
+
+            advance();
+
+            // Check if next request has the same clock, only then skip clock increment
+            if (m_curr_trace_idx < m_trace_length && m_trace[m_curr_trace_idx].clk == clk)
+            {
+                return; // Do not increment clock
+            }
+
+            clk++; // Increment clock if no more requests for this clock
+        }
+
+        Clk_t get_num_idle_ticks() override
+        {
+            // Only a trace that respects its timestamps idles, each tick until the next record is due just increments clk
+            // (unless the translation has work of its own in every tick)
+            if (!m_respect_timestamps || m_curr_trace_idx >= m_trace_length || !m_translation->is_idle())
+            {
+                return 0;
+            }
+            const auto &t = m_trace[m_curr_trace_idx];
+            return t.clk > clk ? t.clk - clk : 0;
+        }
+
+        void skip_idle_ticks(Clk_t n) override
+        {
+            clk += n;
+        }
+
+        bool is_finished() override
+        {
+            return m_curr_trace_idx >= m_trace_length;
+        }
+
+    private:
+        void init_trace(const std::string &file_path_str)
+        {
+            fs::path trace_path(file_path_str);
+            if (!fs::exists(trace_path))
+            {
+                throw ConfigurationError("Trace {} does not exist!", file_path_str);
+            }
+
+            m_fd = open(file_path_str.c_str(), O_RDONLY);
+            if (m_fd == -1)
+            {
+                throw ConfigurationError("Trace {} cannot be opened!", file_path_str);
+            }
+
+            struct stat st;
+            if (fstat(m_fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(BinaryTraceHeader))
+            {
+                throw ConfigurationError("Trace {} is too small to be a binary trace!", file_path_str);
+            }
+            m_map_size = st.st_size;
+
+            m_map = mmap(nullptr, m_map_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+            if (m_map == MAP_FAILED)
+            {
+                m_map = nullptr;
+                throw ConfigurationError("Trace {} cannot be mapped!", file_path_str);
+            }
+            madvise(m_map, m_map_size, MADV_SEQUENTIAL);
+
+            BinaryTraceHeader header;
+            std::memcpy(&header, m_map, sizeof(header));
+            if (std::memcmp(header.magic, BinaryTraceHeader::MAGIC, sizeof(header.magic)) != 0)
+            {
+                throw ConfigurationError("Trace {} is not a binary trace (bad magic)!", file_path_str);
+            }
+            if (header.version != BinaryTraceHeader::VERSION || header.record_size != sizeof(BinaryTraceRecord))
+            {
+                throw ConfigurationError("Trace {} has unsupported version {} (record size {})!", file_path_str, header.version, header.record_size);
+            }
+
+            size_t available = (m_map_size - sizeof(BinaryTraceHeader)) / sizeof(BinaryTraceRecord);
+            if (header.num_records > available)
+            {
+                throw ConfigurationError("Trace {} is truncated: header says {} records, file holds {}!", file_path_str, header.num_records, available);
+            }
+            if (header.num_records == 0)
+            {
+                throw ConfigurationError("Trace {} is empty!", file_path_str);
+            }
+
+            m_trace = reinterpret_cast<const BinaryTraceRecord *>(static_cast<const char *>(m_map) + sizeof(BinaryTraceHeader));
+            m_trace_length = header.num_records;
+        };
+
+        void advance()
+        {
+            m_curr_trace_idx++;
+            if (m_curr_trace_idx - m_released_until < m_release_records)
+            {
+                return;
+            }
+
+            // Drop the page-aligned range of records that has been fully consumed
+            static const size_t page_size = sysconf(_SC_PAGESIZE);
+            const char *base = static_cast<const char *>(m_map);
+            size_t begin = (reinterpret_cast<const char *>(m_trace + m_released_until) - base) / page_size * page_size;
+            size_t end = (reinterpret_cast<const char *>(m_trace + m_curr_trace_idx) - base) / page_size * page_size;
+            if (end > begin)
+            {
+                madvise(const_cast<char *>(base) + begin, end - begin, MADV_DONTNEED);
+            }
+            m_released_until = m_curr_trace_idx;
+        };
+    };
+
+} // namespace Ramulator
@@ -0,0 +1,178 @@
+#ifndef     RAMULATOR_FRONTEND_MEMORY_TRACE_BINARY_TRACE_H
+#define     RAMULATOR_FRONTEND_MEMORY_TRACE_BINARY_TRACE_H
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Ramulator {
+
+/**
+ * @brief    On-disk layout of the binary CustomTrace2 trace.
+ *
+ * @details
+ * A binary trace is a BinaryTraceHeader followed by num_records fixed-size BinaryTraceRecords, both in host byte order.
+ * Each record carries exactly what a "<clk> <R|W> <addr> <source_id>" line of the text format carries, so
+ * the two formats are interchangeable and a trace can be consumed in place through mmap without any parsing.
+ *
+ */
+struct BinaryTraceHeader {
+  static constexpr char     MAGIC[8] = {'R', 'A', 'M', 'T', 'R', 'C', '2', '\0'};
+  static constexpr uint32_t VERSION  = 1;
+
+  char      magic[8];
+  uint32_t  version;
+  uint32_t  record_size;
+  uint64_t  num_records;
+};
+static_assert(sizeof(BinaryTraceHeader) == 24, "BinaryTraceHeader must be 24 bytes!");
+
+struct BinaryTraceRecord {
+  uint64_t  clk;
+  int64_t   addr;
+  int32_t   source_id;
+  uint32_t  type_id;    // Request::Type (0 = Read, 1 = Write)
+};
+static_assert(sizeof(BinaryTraceRecord) == 24, "BinaryTraceRecord must be 24 bytes!");
+
+
+/**
+ * @brief    Parses one "<clk> <R|W> <addr> <source_id>" line of the text CustomTrace2 format.
+ *
+ * @return   true     The line is well-formed and record is filled in.
+ * @return   false    The line is malformed.
+ */
+inline bool parse_text_trace_line(std::string_view line, BinaryTraceRecord& record) {
+  const char* curr = line.data();
+  const char* end = line.data() + line.size();
+
+  auto skip_space = [&]() { while (curr < end && (*curr == ' ' || *curr == '\t' || *curr == '\r')) curr++; };
+
+  skip_space();
+  auto [clk_end, clk_ec] = std::from_chars(curr, end, record.clk);
+  if (clk_ec != std::errc() || clk_end == end || *clk_end != ' ') return false;
+  curr = clk_end;
+
+  skip_space();
+  if (curr == end) return false;
+  if (*curr == 'R') {
+    record.type_id = 0;
+  } else if (*curr == 'W') {
+    record.type_id = 1;
+  } else {
+    return false;
+  }
+  curr++;
+  if (curr == end || *curr != ' ') return false;
+
+  skip_space();
+  auto [addr_end, addr_ec] = std::from_chars(curr, end, record.addr);
+  if (addr_ec != std::errc() || addr_end == end || *addr_end != ' ') return false;
+  curr = addr_end;
+
+  skip_space();
+  auto [src_end, src_ec] = std::from_chars(curr, end, record.source_id);
+  if (src_ec != std::errc()) return false;
+  curr = src_end;
+
+  skip_space();
+  return curr == end;
+};
+
+
+/**
+ * @brief    Buffered, streaming writer for the binary trace format.
+ *
+ * @details
+ * Records are accumulated in a fixed-size buffer and flushed with a single fwrite,
+ * the record count in the header is patched in close(). Failed writes throw std::runtime_error.
+ * A writer destroyed without close() (e.g., while an exception unwinds) leaves a trace with no records.
+ *
+ */
+class BinaryTraceWriter {
+  private:
+    FILE* m_file = nullptr;
+    std::string m_path;
+    std::vector<BinaryTraceRecord> m_buffer;
+    size_t m_buffer_size = 0;
+    uint64_t m_num_records = 0;
+
+  public:
+    explicit BinaryTraceWriter(size_t buffer_records = 1 << 16) : m_buffer_size(buffer_records) {
+      m_buffer.reserve(m_buffer_size);
+    };
+
+    ~BinaryTraceWriter() {
+      if (m_file != nullptr) {
+        std::fclose(m_file);
+      }
+    };
+
+    bool open(const std::string& path) {
+      m_file = std::fopen(path.c_str(), "wb");
+      if (m_file == nullptr) {
+        return false;
+      }
+      m_path = path;
+      m_num_records = 0;
+      BinaryTraceHeader header = make_header(0);
+      return std::fwrite(&header, sizeof(header), 1, m_file) == 1;
+    };
+
+    void write(const BinaryTraceRecord& record) {
+      m_buffer.push_back(record);
+      if (m_buffer.size() == m_buffer_size) {
+        flush();
+      }
+    };
+
+    void write(uint64_t clk, int64_t addr, int32_t source_id, bool is_write) {
+      write({clk, addr, source_id, is_write ? 1u : 0u});
+    };
+
+    void close() {
+      if (m_file == nullptr) {
+        return;
+      }
+      flush();
+      BinaryTraceHeader header = make_header(m_num_records);
+      bool ok = std::fseek(m_file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, m_file) == 1;
+      ok = std::fclose(m_file) == 0 && ok;
+      m_file = nullptr;
+      if (!ok) {
+        throw std::runtime_error("Cannot write the header of binary trace " + m_path + "!");
+      }
+    };
+
+    uint64_t num_records() const { return m_num_records; };
+
+  private:
+    void flush() {
+      if (m_buffer.empty()) {
+        return;
+      }
+      if (std::fwrite(m_buffer.data(), sizeof(BinaryTraceRecord), m_buffer.size(), m_file) != m_buffer.size()) {
+        throw std::runtime_error("Cannot write to binary trace " + m_path + "!");
+      }
+      m_num_records += m_buffer.size();
+      m_buffer.clear();
+    };
+
+    static BinaryTraceHeader make_header(uint64_t num_records) {
+      BinaryTraceHeader header;
+      std::memcpy(header.magic, BinaryTraceHeader::MAGIC, sizeof(header.magic));
+      header.version = BinaryTraceHeader::VERSION;
+      header.record_size = sizeof(BinaryTraceRecord);
+      header.num_records = num_records;
+      return header;
+    };
+};
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_FRONTEND_MEMORY_TRACE_BINARY_TRACE_H
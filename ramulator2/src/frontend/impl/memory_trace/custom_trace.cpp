@@ -47,6 +47,8 @@ namespace Ramulator
 
     void tick() override
     {
+      m_translation->tick();
+
       const Trace &t = m_trace[m_curr_trace_idx];
       Request req(t.addr, t.is_write ? Request::Type::Write : Request::Type::Read, t.source_id);
 
@@ -31,12 +31,14 @@ namespace Ramulator
         Logger_t m_logger;
         ITranslation *m_translation; // Translation module instance
         uint64_t clk = 0;            // Current clock cycle
+        bool m_respect_timestamps = false;
 
     public:
         void init() override
         {
             std::string trace_path_str = param<std::string>("path").desc("Path to the load store trace file.").required();
             m_clock_ratio = param<uint>("clock_ratio").required();
+            m_respect_timestamps = param<bool>("respect_timestamps").desc("Issue each record no earlier than its clk instead of replaying the records back to back.").default_val(false);
 
             m_logger = Logging::create_logger("CustomTrace2");
             m_logger->info("Loading trace file {} ...", trace_path_str);
@@ -48,11 +50,12 @@ namespace Ramulator
 
         void tick() override
         {
+            m_translation->tick();
 
             const Trace &t = m_trace[m_curr_trace_idx];
 
             // Wait if trace is for future clk
-            if (t.clk < clk)
+            if (m_respect_timestamps ? (t.clk > clk) : (t.clk < clk))
             {
                 clk++;
                 return;
@@ -83,6 +86,23 @@ namespace Ramulator
             clk++; // Increment clock if no more requests for this clock
         }
 
+        Clk_t get_num_idle_ticks() override
+        {
+            // Only a trace that respects its timestamps idles, each tick until the next record is due just increments clk
+            // (unless the translation has work of its own in every tick)
+            if (!m_respect_timestamps || m_curr_trace_idx >= m_trace.size() || !m_translation->is_idle())
+            {
+                return 0;
+            }
+            const auto &t = m_trace[m_curr_trace_idx];
+            return t.clk > clk ? t.clk - clk : 0;
+        }
+
+        void skip_idle_ticks(Clk_t n) override
+        {
+            clk += n;
+        }
+
     private:
         void init_trace(const std::string &file_path_str)
         {
@@ -98,6 +98,7 @@ void BHO3::tick() {
     m_logger->info("Processor Heartbeat {} cycles.", m_clk);
   }
 
+  m_translation->tick();
   m_llc->tick();
   for (auto core : m_cores) {
     core->tick();
@@ -0,0 +1,236 @@
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "base/exception.h"
+#include "frontend/impl/processor/simpleO3/binary_inst_trace.h"
+
+namespace Ramulator {
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief    A mapped binary SimpleO3 trace and the offsets of its chunks.
+ */
+class BinaryInstTraceReader::File {
+  private:
+    std::string m_path;
+    int m_fd = -1;
+    void* m_map = nullptr;
+    size_t m_map_size = 0;
+
+  public:
+    BinaryInstTraceHeader header;
+    std::vector<size_t> chunk_offsets;
+
+  public:
+    explicit File(const std::string& path);
+    ~File();
+
+    void decode_chunk(size_t chunk_id, std::vector<SimpleO3Inst>& insts) const;
+
+    /**
+     * @brief    Returns the mapping of the file at path, mapping it if no reader has it mapped.
+     */
+    static std::shared_ptr<const File> open(const std::string& path);
+};
+
+BinaryInstTraceReader::File::File(const std::string& path) : m_path(path) {
+  if (!fs::exists(path)) {
+    throw ConfigurationError("Trace {} does not exist!", path);
+  }
+
+  m_fd = ::open(path.c_str(), O_RDONLY);
+  if (m_fd == -1) {
+    throw ConfigurationError("Trace {} cannot be opened!", path);
+  }
+
+  struct stat st;
+  if (fstat(m_fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(BinaryInstTraceHeader)) {
+    throw ConfigurationError("Trace {} is too small to be a binary trace!", path);
+  }
+  m_map_size = st.st_size;
+
+  m_map = mmap(nullptr, m_map_size, PROT_READ, MAP_SHARED, m_fd, 0);
+  if (m_map == MAP_FAILED) {
+    m_map = nullptr;
+    throw ConfigurationError("Trace {} cannot be mapped!", path);
+  }
+  madvise(m_map, m_map_size, MADV_SEQUENTIAL);
+
+  std::memcpy(&header, m_map, sizeof(header));
+  if (std::memcmp(header.magic, BinaryInstTraceHeader::MAGIC, sizeof(header.magic)) != 0) {
+    throw ConfigurationError("Trace {} is not a binary SimpleO3 trace (bad magic)!", path);
+  }
+  if (header.version != BinaryInstTraceHeader::VERSION) {
+    throw ConfigurationError("Trace {} has unsupported version {}!", path, header.version);
+  }
+  if (header.num_insts == 0) {
+    throw ConfigurationError("Trace {} is empty!", path);
+  }
+
+  // Only the chunk headers are touched here, the instructions are decoded by the readers
+  size_t offset = sizeof(BinaryInstTraceHeader);
+  uint64_t num_insts = 0;
+  chunk_offsets.reserve(header.num_chunks);
+  for (uint64_t i = 0; i < header.num_chunks; i++) {
+    BinaryInstTraceChunk chunk;
+    if (offset + sizeof(chunk) > m_map_size) {
+      break;
+    }
+    std::memcpy(&chunk, static_cast<const char*>(m_map) + offset, sizeof(chunk));
+    if (offset + sizeof(chunk) + chunk.num_bytes > m_map_size || chunk.num_insts > header.chunk_insts) {
+      break;
+    }
+    if (chunk.num_insts == 0) {
+      throw ConfigurationError("Trace {} is corrupt: chunk {} holds no instructions!", path, i);
+    }
+    chunk_offsets.push_back(offset);
+    num_insts += chunk.num_insts;
+    offset += sizeof(chunk) + chunk.num_bytes;
+  }
+  if (chunk_offsets.size() != header.num_chunks || num_insts != header.num_insts) {
+    throw ConfigurationError("Trace {} is truncated: header says {} instructions, file holds {}!", path, header.num_insts, num_insts);
+  }
+}
+
+BinaryInstTraceReader::File::~File() {
+  if (m_map != nullptr) {
+    munmap(m_map, m_map_size);
+  }
+  if (m_fd != -1) {
+    close(m_fd);
+  }
+}
+
+void BinaryInstTraceReader::File::decode_chunk(size_t chunk_id, std::vector<SimpleO3Inst>& insts) const {
+  using namespace BinaryInstTraceCodec;
+
+  const char* base = static_cast<const char*>(m_map) + chunk_offsets[chunk_id];
+  BinaryInstTraceChunk chunk;
+  std::memcpy(&chunk, base, sizeof(chunk));
+
+  const uint8_t* begin = reinterpret_cast<const uint8_t*>(base + sizeof(chunk));
+  const uint8_t* end = begin + chunk.num_bytes;
+  const uint8_t* curr = begin;
+  Addr_t prev_load = 0;
+  Addr_t prev_store = 0;
+  insts.resize(chunk.num_insts);
+  for (auto& inst : insts) {
+    uint64_t word = get_varint(curr, end);
+    inst.bubble_count = word >> 2;
+    inst.load_addr = -1;
+    inst.store_addr = -1;
+    if (word & 1) {
+      prev_load += unzigzag(get_varint(curr, end));
+      inst.load_addr = prev_load;
+    }
+    if (word & 2) {
+      prev_store += unzigzag(get_varint(curr, end));
+      inst.store_addr = prev_store;
+    }
+  }
+  if (curr != end) {
+    throw ConfigurationError("Trace {} is corrupt: chunk {} decodes {} of its {} bytes!", m_path, chunk_id, curr - begin, chunk.num_bytes);
+  }
+}
+
+std::shared_ptr<const BinaryInstTraceReader::File> BinaryInstTraceReader::File::open(const std::string& path) {
+  static std::mutex mutex;
+  static std::map<std::string, std::weak_ptr<const File>> files;
+
+  std::string key = fs::weakly_canonical(path).string();
+  std::lock_guard<std::mutex> lock(mutex);
+  std::shared_ptr<const File> file = files[key].lock();
+  if (!file) {
+    file = std::make_shared<const File>(path);
+    files[key] = file;
+  }
+  return file;
+}
+
+
+bool BinaryInstTraceReader::is_binary_trace(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  char magic[sizeof(BinaryInstTraceHeader::MAGIC)] = {};
+  file.read(magic, sizeof(magic));
+  return file && std::memcmp(magic, BinaryInstTraceHeader::MAGIC, sizeof(magic)) == 0;
+}
+
+BinaryInstTraceReader::BinaryInstTraceReader(const std::string& path) : m_file(File::open(path)) {
+  m_curr_chunk.reserve(m_file->header.chunk_insts);
+  m_next_chunk.reserve(m_file->header.chunk_insts);
+
+  // Decode the first chunk here, the prefetch thread starts with the second one
+  m_file->decode_chunk(0, m_curr_chunk);
+  m_next_chunk_id = 1 % m_file->chunk_offsets.size();
+  m_prefetcher = std::thread(&BinaryInstTraceReader::prefetch, this);
+}
+
+BinaryInstTraceReader::~BinaryInstTraceReader() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  m_prefetcher.join();
+}
+
+uint64_t BinaryInstTraceReader::num_insts() const {
+  return m_file->header.num_insts;
+}
+
+void BinaryInstTraceReader::next_chunk() {
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_next_ready; });
+    if (m_error) {
+      std::rethrow_exception(m_error);
+    }
+    std::swap(m_curr_chunk, m_next_chunk);
+    m_next_ready = false;
+  }
+  // Let the prefetch thread decode the chunk after this one into the buffer that was just consumed
+  m_cv.notify_all();
+  m_curr_idx = 0;
+}
+
+void BinaryInstTraceReader::prefetch() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_cv.wait(lock, [this] { return m_stop || !m_next_ready; });
+    if (m_stop) {
+      return;
+    }
+
+    // The buffer is not touched by the core until m_next_ready is set
+    size_t chunk_id = m_next_chunk_id;
+    lock.unlock();
+    std::exception_ptr error;
+    try {
+      m_file->decode_chunk(chunk_id, m_next_chunk);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    lock.lock();
+
+    // Hand the error to the core, which rethrows it when it reaches this chunk
+    if (error) {
+      m_error = error;
+      m_next_ready = true;
+      m_cv.notify_all();
+      return;
+    }
+
+    m_next_chunk_id = (chunk_id + 1) % m_file->chunk_offsets.size();
+    m_next_ready = true;
+    m_cv.notify_all();
+  }
+}
+
+}        // namespace Ramulator
@@ -0,0 +1,293 @@
+#ifndef     RAMULATOR_FRONTEND_PROCESSOR_SIMPLEO3_BINARY_INST_TRACE_H
+#define     RAMULATOR_FRONTEND_PROCESSOR_SIMPLEO3_BINARY_INST_TRACE_H
+
+#include <charconv>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "base/exception.h"
+#include "base/type.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    One instruction of a SimpleO3 trace: <num_non_memory_insts> <load_addr> [writeback_addr]
+ */
+struct SimpleO3Inst {
+  int bubble_count = 0;
+  Addr_t load_addr = -1;
+  Addr_t store_addr = -1;
+};
+
+/**
+ * @brief    On-disk layout of the binary SimpleO3 trace.
+ *
+ * @details
+ * A binary trace is a BinaryInstTraceHeader followed by num_chunks chunks. A chunk is a BinaryInstTraceChunk
+ * followed by num_bytes of encoded instructions. Each instruction is a varint of (bubble_count << 2 | has_store << 1 |
+ * has_load), followed by the zigzag varint delta of the load and then of the writeback address to the previous load
+ * and writeback address of the chunk. The deltas start from 0 in every chunk, so chunks can be decoded on their own.
+ * Integers in the headers are in host byte order.
+ *
+ */
+struct BinaryInstTraceHeader {
+  static constexpr char     MAGIC[8] = {'R', 'A', 'M', 'O', '3', 'T', 'R', '\0'};
+  static constexpr uint32_t VERSION  = 1;
+
+  char      magic[8];
+  uint32_t  version;
+  uint32_t  chunk_insts;    // Maximum number of instructions in a chunk
+  uint64_t  num_insts;
+  uint64_t  num_chunks;
+};
+static_assert(sizeof(BinaryInstTraceHeader) == 32, "BinaryInstTraceHeader must be 32 bytes!");
+
+struct BinaryInstTraceChunk {
+  uint32_t  num_insts;
+  uint32_t  num_bytes;
+};
+static_assert(sizeof(BinaryInstTraceChunk) == 8, "BinaryInstTraceChunk must be 8 bytes!");
+
+
+/**
+ * @brief    Parses one "<num_non_memory_insts> <load_addr> [writeback_addr]" line of the text SimpleO3 trace.
+ *
+ * @return   true     The line is well-formed and inst is filled in.
+ * @return   false    The line is malformed.
+ */
+inline bool parse_inst_trace_line(std::string_view line, SimpleO3Inst& inst) {
+  const char* curr = line.data();
+  const char* end = line.data() + line.size();
+
+  auto skip_space = [&]() { while (curr < end && (*curr == ' ' || *curr == '\t' || *curr == '\r')) curr++; };
+  auto parse_addr = [&](Addr_t& addr) {
+    auto [addr_end, addr_ec] = std::from_chars(curr, end, addr);
+    if (addr_ec != std::errc()) return false;
+    curr = addr_end;
+    return curr == end || *curr == ' ' || *curr == '\t' || *curr == '\r';
+  };
+
+  skip_space();
+  auto [bubble_end, bubble_ec] = std::from_chars(curr, end, inst.bubble_count);
+  if (bubble_ec != std::errc() || inst.bubble_count < 0 || bubble_end == end || (*bubble_end != ' ' && *bubble_end != '\t')) return false;
+  curr = bubble_end;
+
+  skip_space();
+  if (!parse_addr(inst.load_addr)) return false;
+
+  skip_space();
+  inst.store_addr = -1;
+  if (curr != end && !parse_addr(inst.store_addr)) return false;
+
+  skip_space();
+  return curr == end;
+};
+
+
+namespace BinaryInstTraceCodec {
+  inline void put_varint(std::vector<uint8_t>& out, uint64_t val) {
+    while (val >= 0x80) {
+      out.push_back(uint8_t(val) | 0x80);
+      val >>= 7;
+    }
+    out.push_back(uint8_t(val));
+  };
+
+  /**
+   * @brief    Decodes the varint at curr, which must end before end. A 64-bit value takes at most 10 bytes.
+   */
+  inline uint64_t get_varint(const uint8_t*& curr, const uint8_t* end) {
+    uint64_t val = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (curr == end) {
+        throw ConfigurationError("Corrupt binary trace: varint runs past the end of the chunk!");
+      }
+      uint8_t byte = *curr++;
+      val |= uint64_t(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        return val;
+      }
+    }
+    throw ConfigurationError("Corrupt binary trace: varint is longer than 10 bytes!");
+  };
+
+  inline uint64_t zigzag(int64_t val) { return (uint64_t(val) << 1) ^ uint64_t(val >> 63); };
+  inline int64_t unzigzag(uint64_t val) { return int64_t(val >> 1) ^ -int64_t(val & 1); };
+}        // namespace BinaryInstTraceCodec
+
+
+/**
+ * @brief    Buffered, streaming writer for the binary SimpleO3 trace format.
+ *
+ * @details
+ * Instructions are encoded into the current chunk, which is written out with a single fwrite when it is full.
+ * The instruction and chunk counts in the header are patched in close(). Failed writes throw std::runtime_error.
+ * A writer destroyed without close() (e.g., while an exception unwinds) leaves a trace with no instructions.
+ *
+ */
+class BinaryInstTraceWriter {
+  private:
+    FILE* m_file = nullptr;
+    std::string m_path;
+    uint32_t m_chunk_insts = 0;
+    uint32_t m_num_chunk_insts = 0;
+    std::vector<uint8_t> m_chunk;
+    Addr_t m_prev_load = 0;
+    Addr_t m_prev_store = 0;
+
+    uint64_t m_num_insts = 0;
+    uint64_t m_num_chunks = 0;
+
+  public:
+    explicit BinaryInstTraceWriter(uint32_t chunk_insts = 1 << 16) : m_chunk_insts(chunk_insts) {};
+
+    ~BinaryInstTraceWriter() {
+      if (m_file != nullptr) {
+        std::fclose(m_file);
+      }
+    };
+
+    bool open(const std::string& path) {
+      m_file = std::fopen(path.c_str(), "wb");
+      if (m_file == nullptr) {
+        return false;
+      }
+      m_path = path;
+      m_num_insts = 0;
+      m_num_chunks = 0;
+      start_chunk();
+      BinaryInstTraceHeader header = make_header();
+      return std::fwrite(&header, sizeof(header), 1, m_file) == 1;
+    };
+
+    void write(const SimpleO3Inst& inst) {
+      using namespace BinaryInstTraceCodec;
+      bool has_load = inst.load_addr != -1;
+      bool has_store = inst.store_addr != -1;
+      put_varint(m_chunk, (uint64_t(inst.bubble_count) << 2) | (has_store << 1) | has_load);
+      if (has_load) {
+        put_varint(m_chunk, zigzag(inst.load_addr - m_prev_load));
+        m_prev_load = inst.load_addr;
+      }
+      if (has_store) {
+        put_varint(m_chunk, zigzag(inst.store_addr - m_prev_store));
+        m_prev_store = inst.store_addr;
+      }
+      if (++m_num_chunk_insts == m_chunk_insts) {
+        flush();
+      }
+    };
+
+    void close() {
+      if (m_file == nullptr) {
+        return;
+      }
+      flush();
+      BinaryInstTraceHeader header = make_header();
+      bool ok = std::fseek(m_file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, m_file) == 1;
+      ok = std::fclose(m_file) == 0 && ok;
+      m_file = nullptr;
+      if (!ok) {
+        throw std::runtime_error("Cannot write the header of binary trace " + m_path + "!");
+      }
+    };
+
+    uint64_t num_insts() const { return m_num_insts; };
+
+  private:
+    void start_chunk() {
+      m_chunk.clear();
+      m_num_chunk_insts = 0;
+      m_prev_load = 0;
+      m_prev_store = 0;
+    };
+
+    void flush() {
+      if (m_num_chunk_insts == 0) {
+        return;
+      }
+      BinaryInstTraceChunk chunk = {m_num_chunk_insts, uint32_t(m_chunk.size())};
+      if (std::fwrite(&chunk, sizeof(chunk), 1, m_file) != 1 || std::fwrite(m_chunk.data(), 1, m_chunk.size(), m_file) != m_chunk.size()) {
+        throw std::runtime_error("Cannot write to binary trace " + m_path + "!");
+      }
+      m_num_insts += m_num_chunk_insts;
+      m_num_chunks++;
+      start_chunk();
+    };
+
+    BinaryInstTraceHeader make_header() const {
+      BinaryInstTraceHeader header;
+      std::memcpy(header.magic, BinaryInstTraceHeader::MAGIC, sizeof(header.magic));
+      header.version = BinaryInstTraceHeader::VERSION;
+      header.chunk_insts = m_chunk_insts;
+      header.num_insts = m_num_insts;
+      header.num_chunks = m_num_chunks;
+      return header;
+    };
+};
+
+
+/**
+ * @brief    Streaming reader of a binary SimpleO3 trace, wrapping around at the end of the trace.
+ *
+ * @details
+ * The trace file is memory-mapped once and shared by all readers of the same path. Each reader holds two decoded
+ * chunks: the one being consumed and the next one, which a background thread decodes while the current one is
+ * consumed. Memory use is two chunks per reader, independent of the trace length.
+ *
+ */
+class BinaryInstTraceReader {
+  private:
+    class File;
+
+    std::shared_ptr<const File> m_file;
+
+    std::vector<SimpleO3Inst> m_curr_chunk;
+    size_t m_curr_idx = 0;
+
+    // Shared with the prefetch thread
+    std::vector<SimpleO3Inst> m_next_chunk;
+    size_t m_next_chunk_id = 0;
+    bool m_next_ready = false;
+    bool m_stop = false;
+    std::exception_ptr m_error;    // Set by the prefetch thread if the next chunk is corrupt
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::thread m_prefetcher;
+
+  public:
+    /**
+     * @brief    Whether the file starts with the magic of the binary SimpleO3 trace.
+     */
+    static bool is_binary_trace(const std::string& path);
+
+    explicit BinaryInstTraceReader(const std::string& path);
+    ~BinaryInstTraceReader();
+
+    const SimpleO3Inst& get_next_inst() {
+      if (m_curr_idx == m_curr_chunk.size()) {
+        next_chunk();
+      }
+      return m_curr_chunk[m_curr_idx++];
+    };
+
+    uint64_t num_insts() const;
+
+  private:
+    void next_chunk();
+    void prefetch();
+};
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_FRONTEND_PROCESSOR_SIMPLEO3_BINARY_INST_TRACE_H
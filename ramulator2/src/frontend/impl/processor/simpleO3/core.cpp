@@ -22,6 +22,12 @@ namespace Ramulator
       throw ConfigurationError("Trace {} does not exist!", file_path_str);
     }
 
+    if (BinaryInstTraceReader::is_binary_trace(file_path_str))
+    {
+      m_reader = std::make_unique<BinaryInstTraceReader>(file_path_str);
+      return;
+    }
+
     std::ifstream trace_file(trace_path);
     if (!trace_file.is_open())
     {
@@ -29,55 +35,55 @@ namespace Ramulator
     }
 
     std::string line;
+    size_t line_num = 0;
+    Inst inst;
     while (std::getline(trace_file, line))
     {
-      std::vector<std::string> tokens;
-      tokenize(tokens, line, " ");
-
-      int num_tokens = tokens.size();
-      if (num_tokens != 2 & num_tokens != 3)
+      line_num++;
+      if (line.empty() || line == "\r")
       {
-        throw ConfigurationError("Trace {} format invalid!", file_path_str);
+        continue;
       }
-      // int bubble_count = std::stoi(tokens[0]);
-      int bubble_count = 0;
-      try
+      if (!parse_inst_trace_line(line, inst))
       {
-        bubble_count = std::stoi(tokens[0]);
-      }
-      catch (const std::exception &e)
-      {
-        std::cerr << "Warning: Failed to parse bubble_count from token '" << tokens[0]
-                  << "': " << e.what() << std::endl;
-        bubble_count = 5; // or a fallback value you find appropriate
-      }
-      Addr_t load_addr = std::stoll(tokens[1]);
-
-      bool has_store = num_tokens == 2 ? false : true;
-      if (has_store)
-      {
-        Addr_t store_addr = std::stoll(tokens[2]);
-        m_trace.push_back({bubble_count, load_addr, store_addr});
-      }
-      else
-      {
-        m_trace.push_back({bubble_count, load_addr, -1});
+        throw ConfigurationError("Trace {} format invalid at line {}: '{}'!", file_path_str, line_num, line);
       }
+      m_trace.push_back(inst);
     }
 
     trace_file.close();
     m_trace_length = m_trace.size();
+    if (m_trace_length == 0)
+    {
+      throw ConfigurationError("Trace {} is empty!", file_path_str);
+    }
   }
 
   const SimpleO3Core::Trace::Inst &SimpleO3Core::Trace::get_next_inst()
   {
+    if (m_reader)
+    {
+      return m_reader->get_next_inst();
+    }
+
     const Inst &inst = m_trace[m_curr_trace_idx];
     m_curr_trace_idx = (m_curr_trace_idx + 1) % m_trace_length;
     return inst;
   }
 
-  SimpleO3Core::InstWindow::InstWindow(int ipc, int depth) : m_ipc(ipc), m_depth(depth),
-                                                             m_ready_list(depth, false), m_addr_list(depth, -1) {};
+  SimpleO3Core::InstWindow::InstWindow(int ipc, int depth, int lq_size) : m_ipc(ipc), m_depth(depth),
+                                                                          m_lq_size(lq_size > 0 ? lq_size : depth),
+                                                                          m_ready_list(depth, false), m_load_list(depth, false), m_next_list(depth, -1)
+  {
+    // At most one address per window entry, keep the table at most half full
+    size_t num_slots = 1;
+    while (num_slots < 2 * (size_t)depth)
+    {
+      num_slots <<= 1;
+    }
+    m_addr_index.resize(num_slots);
+    m_addr_index_mask = num_slots - 1;
+  };
 
   bool SimpleO3Core::InstWindow::is_full()
   {
@@ -87,7 +93,29 @@ namespace Ramulator
   void SimpleO3Core::InstWindow::insert(bool ready, Addr_t addr)
   {
     m_ready_list.at(m_head_idx) = ready;
-    m_addr_list.at(m_head_idx) = addr;
+    m_load_list.at(m_head_idx) = (addr != -1);
+    m_next_list.at(m_head_idx) = -1;
+
+    if (addr != -1)
+    {
+      m_num_loads++;
+    }
+    if (!ready)
+    {
+      // Append the load to the waiting loads of its address
+      AddrSlot &slot = m_addr_index[find_addr_slot(addr)];
+      if (slot.addr == -1)
+      {
+        slot.addr = addr;
+        slot.first = m_head_idx;
+      }
+      else
+      {
+        m_next_list[slot.last] = m_head_idx;
+      }
+      slot.last = m_head_idx;
+      m_num_waiting_loads++;
+    }
 
     m_head_idx = (m_head_idx + 1) % m_depth;
     m_load++;
@@ -104,6 +132,10 @@ namespace Ramulator
       if (!m_ready_list.at(m_tail_idx))
         break;
 
+      if (m_load_list[m_tail_idx])
+      {
+        m_num_loads--;
+      }
       m_tail_idx = (m_tail_idx + 1) % m_depth;
       m_load--;
       num_retired++;
@@ -113,25 +145,55 @@ namespace Ramulator
 
   void SimpleO3Core::InstWindow::set_ready(Addr_t addr)
   {
-    if (m_load == 0)
+    size_t slot_idx = find_addr_slot(addr);
+    AddrSlot &slot = m_addr_index[slot_idx];
+    if (slot.addr == -1)
       return;
 
-    int index = m_tail_idx;
-    for (int i = 0; i < m_load; i++)
+    // A response readies all loads waiting for the address
+    for (int index = slot.first; index != -1; index = m_next_list[index])
     {
-      if (m_addr_list[index] == addr)
+      m_ready_list[index] = true;
+      m_num_waiting_loads--;
+    }
+    erase_addr_slot(slot_idx);
+  }
+
+  size_t SimpleO3Core::InstWindow::find_addr_slot(Addr_t addr)
+  {
+    uint64_t hash = (uint64_t)addr * 0x9E3779B97F4A7C15ull;
+    size_t i = (hash ^ (hash >> 32)) & m_addr_index_mask;
+    while (m_addr_index[i].addr != -1 && m_addr_index[i].addr != addr)
+    {
+      i = (i + 1) & m_addr_index_mask;
+    }
+    return i;
+  }
+
+  void SimpleO3Core::InstWindow::erase_addr_slot(size_t i)
+  {
+    // Move back every following slot of the probe run that would otherwise become unreachable
+    size_t j = i;
+    while (true)
+    {
+      j = (j + 1) & m_addr_index_mask;
+      if (m_addr_index[j].addr == -1)
       {
-        m_ready_list[index] = true;
+        break;
       }
-      index++;
-      if (index == m_depth)
+      uint64_t hash = (uint64_t)m_addr_index[j].addr * 0x9E3779B97F4A7C15ull;
+      size_t k = (hash ^ (hash >> 32)) & m_addr_index_mask;
+      bool reachable = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+      if (!reachable)
       {
-        index = 0;
+        m_addr_index[i] = m_addr_index[j];
+        i = j;
       }
     }
+    m_addr_index[i] = AddrSlot();
   }
 
-  SimpleO3Core::SimpleO3Core(int id, int ipc, int depth, size_t num_expected_insts, std::string trace_path, ITranslation *translation, SimpleO3LLC *llc) : m_id(id), m_window(ipc, depth), m_trace(trace_path), m_num_expected_insts(num_expected_insts), m_translation(translation), m_llc(llc)
+  SimpleO3Core::SimpleO3Core(int id, int ipc, int depth, int lq_size, int sq_size, size_t num_expected_insts, std::string trace_path, ITranslation *translation, SimpleO3LLC *llc) : m_id(id), m_window(ipc, depth, lq_size), m_trace(trace_path), m_num_expected_insts(num_expected_insts), m_translation(translation), m_llc(llc), m_sq_size(sq_size)
   {
     // Fetch the instructions and addresses for tick 0
     auto inst = m_trace.get_next_inst();
@@ -154,6 +216,19 @@ namespace Ramulator
       }
     }
 
+    int num_waiting_loads = m_window.get_num_waiting_loads();
+    if (!reached_expected_num_insts && num_waiting_loads > 0)
+    {
+      s_mlp_cycles++;
+      s_mlp_waiting_loads += num_waiting_loads;
+    }
+
+    // Drain the store queue, one writeback per cycle
+    if (!m_store_queue.empty() && m_llc->send(m_store_queue.front()))
+    {
+      m_store_queue.pop_front();
+    }
+
     // First, issue the non-memory instructions
     int num_inserted_insts = 0;
     while (m_num_bubbles > 0)
@@ -182,6 +257,14 @@ namespace Ramulator
       {
         return;
       };
+      if (m_window.is_lq_full())
+      {
+        if (!reached_expected_num_insts)
+        {
+          s_lq_full_cycles++;
+        }
+        return;
+      }
 
       Request load_request(m_load_addr, Request::Type::Read, m_id, m_callback);
       if (!m_translation->translate(load_request))
@@ -211,12 +294,26 @@ namespace Ramulator
     if (m_writeback_addr != -1)
     {
 
+      if (m_sq_size > 0 && (int)m_store_queue.size() == m_sq_size)
+      {
+        if (!reached_expected_num_insts)
+        {
+          s_sq_full_cycles++;
+        }
+        return;
+      }
+
       Request writeback_request(m_writeback_addr, Request::Type::Write, m_id, m_callback);
       if (!m_translation->translate(writeback_request))
       {
         return;
       };
-      if (!m_llc->send(writeback_request))
+      if (m_sq_size > 0)
+      {
+        // The writeback leaves the core, the store queue sends it to the LLC
+        m_store_queue.push_back(writeback_request);
+      }
+      else if (!m_llc->send(writeback_request))
       {
 
         return;
@@ -243,4 +340,9 @@ namespace Ramulator
     }
   }
 
+  void SimpleO3Core::finalize()
+  {
+    s_avg_mlp = s_mlp_cycles == 0 ? 0 : (float)s_mlp_waiting_loads / s_mlp_cycles;
+  }
+
 } // namespace Ramulator
@@ -2,12 +2,15 @@
 #define     RAMULATOR_FRONTEND_PROCESSOR_CORE_H
 
 #include <vector>
+#include <deque>
+#include <memory>
 #include <string>
 #include <functional>
 
 #include "base/type.h"
 #include "base/request.h"
 #include "translation/translation.h"
+#include "frontend/impl/processor/simpleO3/binary_inst_trace.h"
 
 namespace Ramulator {
 
@@ -15,18 +18,21 @@ class SimpleO3LLC;
 
 class SimpleO3Core : public Clocked<SimpleO3Core> {
   friend class SimpleO3;
+  /**
+   * @brief   The instruction trace of a core, looped over until the core has retired the expected instructions.
+   * @details
+   * Text traces are read into memory. Binary traces (see BinaryInstTraceHeader) are streamed chunk by chunk.
+   */
   class Trace {
     friend class SimpleO3Core;
-    struct Inst {
-      int bubble_count = 0;
-      Addr_t load_addr = -1;
-      Addr_t store_addr = -1;
-    };
+    using Inst = SimpleO3Inst;
   
     std::vector<Inst> m_trace;
     size_t m_trace_length = 0;
     size_t m_curr_trace_idx = 0;
 
+    std::unique_ptr<BinaryInstTraceReader> m_reader;
+
     public:
       Trace(std::string file_path_str);
       const Inst& get_next_inst();
@@ -36,25 +42,46 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
    * @brief   Simplified ROB of an O3 processor.
    * @details
    * We model
+   * 
+   * The loads that are still waiting for memory are indexed by address in a small open-addressing table. Loads to
+   * the same address are chained from the oldest to the youngest, and a response readies the whole chain, so waking
+   * up the loads of a response does not scan the window.
    */
   class InstWindow {
     friend class SimpleO3Core;
     private:
+      // An address with waiting loads and the oldest and youngest of them
+      struct AddrSlot {
+        Addr_t addr = -1;     // -1 if the slot is empty
+        int first = -1;
+        int last = -1;
+      };
+
       int m_ipc = 4;          // How many instructions we can retire in a cycle
       int m_depth = 128;      // How many inflight instructions we can keep track of
+      int m_lq_size = 128;    // How many loads can be in the window
 
       int m_load = 0;         // The current load
       int m_head_idx = 0;     // Head index. New instructions are inserted at the head index.
       int m_tail_idx = 0;     // Tail index. The instruction at the tail will be retired first.
 
+      int m_num_loads = 0;          // Loads in the window
+      int m_num_waiting_loads = 0;  // Loads in the window that are not ready yet
+
       std::vector<bool>   m_ready_list;   // Bitvector to mark whether each instruction is ready to be retired.
-      std::vector<Addr_t> m_addr_list;    // Which address is each LD/ST instruction targeting? TODO: Perf. optimization with unordered map?
+      std::vector<bool>   m_load_list;    // Bitvector to mark whether each instruction is a load.
+      std::vector<int>    m_next_list;    // The next younger waiting load to the same address, -1 if none.
+
+      std::vector<AddrSlot> m_addr_index;
+      size_t m_addr_index_mask = 0;
 
     public:
-      InstWindow(int ipc = 4, int depth = 128);      
+      InstWindow(int ipc = 4, int depth = 128, int lq_size = 0);
 
 
       bool   is_full();
+      bool   is_lq_full() { return m_num_loads == m_lq_size; };
+      int    get_num_waiting_loads() { return m_num_waiting_loads; };
 
       /**
        * @brief   Inserts an instruction to the window.
@@ -76,6 +103,10 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
        * 
        */
       void   set_ready(Addr_t addr);
+
+    private:
+      size_t find_addr_slot(Addr_t addr);
+      void   erase_addr_slot(size_t slot);
   };
 
   private:
@@ -86,6 +117,9 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
     ITranslation* m_translation;
     SimpleO3LLC* m_llc;
 
+    int m_sq_size = 0;                  // 0: a writeback that the LLC rejects stalls the core
+    std::deque<Request> m_store_queue;  // Writebacks that wait to be accepted by the LLC
+
     std::function<void(Request&)> m_callback;
 
     int    m_num_bubbles = 0;
@@ -104,8 +138,14 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
     size_t s_cycles_recorded = 0; 
     Clk_t  s_mem_access_cycles = 0; 
 
+    size_t s_mlp_cycles = 0;          // Cycles with at least one load waiting for memory
+    size_t s_mlp_waiting_loads = 0;   // Sum of the waiting loads over these cycles
+    float  s_avg_mlp = 0;             // Memory-level parallelism, s_mlp_waiting_loads / s_mlp_cycles
+    size_t s_lq_full_cycles = 0;      // Cycles in which a load could not be inserted because the load queue is full
+    size_t s_sq_full_cycles = 0;      // Cycles in which a writeback could not be queued because the store queue is full
+
   public:
-    SimpleO3Core(int id, int ipc, int depth, size_t num_expected_insts, std::string trace_path, ITranslation* translation, SimpleO3LLC* llc);
+    SimpleO3Core(int id, int ipc, int depth, int lq_size, int sq_size, size_t num_expected_insts, std::string trace_path, ITranslation* translation, SimpleO3LLC* llc);
 
     /**
      * @brief   Ticks the core.
@@ -118,6 +158,12 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
      * 
      */
     void receive(Request& req);
+
+    /**
+     * @brief   Computes the derived statistics.
+     * 
+     */
+    void finalize();
 };
 
 }        // namespace Ramulator
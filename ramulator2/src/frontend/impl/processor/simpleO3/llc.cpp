@@ -1,76 +1,261 @@
-#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include "base/exception.h"
 #include "frontend/impl/processor/simpleO3/llc.h"
 
 namespace Ramulator {
 
-SimpleO3LLC::SimpleO3LLC(int latency, int size_bytes, int linesize_bytes, int associativity, int num_mshrs)
-  : m_latency(latency), m_size_bytes(size_bytes), m_linesize_bytes(linesize_bytes),
-    m_associativity(associativity), m_num_mshrs(num_mshrs) {
+SimpleO3LLC::SimpleO3LLC(int latency, size_t size_bytes, int linesize_bytes, int associativity, int num_mshrs, int num_slices, bool bypass)
+  : m_bypass(bypass), m_latency(latency), m_size_bytes(size_bytes), m_linesize_bytes(linesize_bytes),
+    m_associativity(associativity), m_num_mshrs(num_mshrs), m_num_slices(num_slices) {
 
   m_logger = Logging::create_logger("SimpleO3LLC");
 
-  m_set_size = m_size_bytes / (m_linesize_bytes * m_associativity);
-  m_index_mask = m_set_size - 1;
-  m_index_offset = calc_log2(m_linesize_bytes);
-  m_tag_offset = calc_log2(m_set_size) + m_index_offset;
-
-  // // Print dummy cache configuration
-  // std::cout << "SimpleO3LLC parameters (Passthrough Mode):" << std::endl;
-  // std::cout << "  Latency: " << m_latency << std::endl;
-  // std::cout << "  Size: " << m_size_bytes << std::endl;
-  // std::cout << "  Linesize: " << m_linesize_bytes << std::endl;
-  // std::cout << "  Associativity: " << m_associativity << std::endl;
-  // std::cout << "  Set size: " << m_set_size << std::endl;
-  // std::cout << "  Number of MSHRs: " << m_num_mshrs << std::endl;
-  // std::cout << "  Index mask: " << std::hex << m_index_mask << std::dec << std::endl;
-  // std::cout << "  Index offset: " << m_index_offset << std::endl;
-  // std::cout << "  Tag offset: " << m_tag_offset << std::endl;
+  if (m_bypass) {
+    return;
+  }
+
+  if (m_num_slices <= 0) {
+    throw ConfigurationError("The LLC needs at least one slice (got {})!", m_num_slices);
+  }
+  m_sets_per_slice = m_size_bytes / (m_linesize_bytes * m_associativity * m_num_slices);
+  if (m_sets_per_slice <= 0) {
+    throw ConfigurationError("The LLC capacity ({} B) is too small for {} slices of {}-way sets!", m_size_bytes, m_num_slices, m_associativity);
+  }
+  m_line_offset = calc_log2(m_linesize_bytes);
+
+  size_t num_ways = size_t(m_num_slices) * m_sets_per_slice * m_associativity;
+  m_tags.resize(num_ways, -1);
+  m_states.resize(num_ways, 0);
+  m_lru.resize(num_ways, 0);
+
+  int num_mshrs_per_slice = std::max(1, m_num_mshrs / m_num_slices);
+  m_slices.resize(m_num_slices);
+  for (auto& slice : m_slices) {
+    slice.mshrs.resize(num_mshrs_per_slice);
+  }
+
+  m_fill_callback = [this](Request& req) { this->receive(req); };
+
+  DEBUG_LOG(DSIMPLEO3LLC, m_logger, "Slices: {}, sets per slice: {}, MSHRs per slice: {}", m_num_slices, m_sets_per_slice, num_mshrs_per_slice);
+}
+
+void SimpleO3LLC::set_slice_latencies(const NUMATopology& topology, int num_cores, double cycles_per_distance) {
+  if (m_bypass) {
+    return;
+  }
+
+  m_slice_latencies.resize(num_cores * m_num_slices, m_latency);
+  for (int core = 0; core < num_cores; core++) {
+    if (!topology.is_core(core)) {
+      continue;
+    }
+    for (int slice = 0; slice < m_num_slices; slice++) {
+      // The stop of the slice, if there are not as many slices as channels
+      int channel = slice * topology.get_num_channels() / m_num_slices;
+      int distance = topology.get_latency(core, channel) - topology.get_min_latency(core);
+      m_slice_latencies[core * m_num_slices + slice] = m_latency + std::lround(distance * cycles_per_distance);
+    }
+  }
+}
+
+int SimpleO3LLC::get_latency(int core, int slice) const {
+  if (core < 0 || (size_t)(core * m_num_slices) >= m_slice_latencies.size()) {
+    return m_latency;
+  }
+  return m_slice_latencies[core * m_num_slices + slice];
 }
 
 void SimpleO3LLC::tick() {
   m_clk++;
-  // Nothing to do — passthrough mode
+
+  if (m_bypass) {
+    return;
+  }
+
+  // Send miss requests to the memory system when the slice latency is met, retry the rejected ones next cycle
+  while (!m_miss_list.empty() && m_miss_list.front().clk <= m_clk) {
+    std::pop_heap(m_miss_list.begin(), m_miss_list.end(), PendingLater());
+    PendingRequest pending = std::move(m_miss_list.back());
+    m_miss_list.pop_back();
+    if (!m_memory_system->send(pending.req)) {
+      m_rejected.push_back(std::move(pending));
+    }
+  }
+  for (auto& pending : m_rejected) {
+    m_miss_list.push_back(std::move(pending));
+    std::push_heap(m_miss_list.begin(), m_miss_list.end(), PendingLater());
+  }
+  m_rejected.clear();
+
+  // Call the callback of hit requests when the slice latency is met
+  while (!m_hit_list.empty() && m_hit_list.front().clk <= m_clk) {
+    std::pop_heap(m_hit_list.begin(), m_hit_list.end(), PendingLater());
+    PendingRequest pending = std::move(m_hit_list.back());
+    m_hit_list.pop_back();
+    pending.req.callback(pending.req);
+  }
 }
 
 bool SimpleO3LLC::send(Request req) {
-  // Directly forward request to memory
-  return m_memory_system->send(req);
+  if (m_bypass) {
+    return m_memory_system->send(req);
+  }
+
+  bool is_write = (req.type_id == Request::Type::Write);
+  Addr_t line = get_line(req.addr);
+  int slice = get_slice(line);
+  size_t set_base = get_set_base(line, slice);
+  int latency = get_latency(req.source_id, slice);
+
+  size_t way = find_way(set_base, line);
+  if (way != npos && (m_states[way] & READY)) {
+    // Hit in the set
+    DEBUG_LOG(DSIMPLEO3LLC, m_logger, "[Clk={}] Request Source: {}, Type: {}, Addr: {}, Slice: {}. Hit, will finish at Clk={}",
+              m_clk, req.source_id, req.type_id, req.addr, slice, m_clk + latency);
+    count_access(is_write, false);
+    m_lru[way] = ++m_lru_stamp;
+    if (is_write) {
+      m_states[way] |= DIRTY;
+    } else {
+      schedule(m_hit_list, m_clk + latency, std::move(req));
+    }
+    return true;
+  }
+
+  // Miss in the set
+  DEBUG_LOG(DSIMPLEO3LLC, m_logger, "[Clk={}] Request Source: {}, Type: {}, Addr: {}, Slice: {}. Miss.",
+            m_clk, req.source_id, req.type_id, req.addr, slice);
+
+  if (way != npos) {
+    // The line is in flight, i.e., MSHR hit
+    count_access(is_write, true);
+    if (is_write) {
+      m_states[way] |= DIRTY;
+    } else {
+      find_mshr(slice, line)->requests.push_back(std::move(req));
+    }
+    return true;
+  }
+
+  Slice& s = m_slices[slice];
+  if (s.num_mshrs_used == (int)s.mshrs.size()) {
+    s_llc_mshr_unavailable++;
+    return false;
+  }
+
+  size_t victim = find_victim(set_base);
+  if (victim == npos) {
+    // All lines of the set are in flight
+    s_llc_set_unavailable++;
+    return false;
+  }
+  if (m_states[victim] & VALID) {
+    evict_line(victim);
+  }
+  count_access(is_write, true);
+  m_tags[victim] = line;
+  m_states[victim] = VALID | (is_write ? DIRTY : 0);
+  m_lru[victim] = ++m_lru_stamp;
+
+  MSHREntry& mshr = *std::find_if(s.mshrs.begin(), s.mshrs.end(), [](const MSHREntry& e) { return e.line == -1; });
+  mshr.line = line;
+  mshr.way = victim;
+  s.num_mshrs_used++;
+
+  // The line is fetched with a read, the core is only waiting for it if the request is a load
+  Request fill_req = req;
+  fill_req.type_id = Request::Type::Read;
+  fill_req.callback = m_fill_callback;
+  if (!is_write) {
+    mshr.requests.push_back(std::move(req));
+  }
+  schedule(m_miss_list, m_clk + latency, std::move(fill_req));
+  return true;
 }
 
 void SimpleO3LLC::receive(Request& req) {
-  // Immediately call the core’s callback
-  req.callback(req);
-}
+  Addr_t line = get_line(req.addr);
+  int slice = get_slice(line);
+  MSHREntry* mshr = find_mshr(slice, line);
+
+  DEBUG_LOG(DSIMPLEO3LLC, m_logger, "[Clk={}] Request {} received.", m_clk, req.addr);
 
-// === All other methods below are now dead code ===
-// === Keep them if needed for serialization, else delete ===
+  if (mshr == nullptr) {
+    return;
+  }
 
-void SimpleO3LLC::serialize(std::string) { }
-void SimpleO3LLC::deserialize(std::string) { }
-void SimpleO3LLC::dump_llc() { }
+  m_states[mshr->way] |= READY;
+  for (auto& waiting_req : mshr->requests) {
+    waiting_req.arrive = req.arrive;
+    waiting_req.depart = req.depart;
+    waiting_req.callback(waiting_req);
+  }
+  mshr->requests.clear();
+  mshr->line = -1;
+  m_slices[slice].num_mshrs_used--;
+}
 
-SimpleO3LLC::CacheSet_t& SimpleO3LLC::get_set(Addr_t) {
-  throw std::logic_error("LLC caching is disabled in passthrough mode.");
+void SimpleO3LLC::count_access(bool is_write, bool is_miss) {
+  // Only accepted requests are counted, the core retries rejected ones every cycle
+  if (is_write) {
+    s_llc_write_access++;
+    s_llc_write_misses += is_miss;
+  } else {
+    s_llc_read_access++;
+    s_llc_read_misses += is_miss;
+  }
 }
 
-SimpleO3LLC::CacheSet_t::iterator SimpleO3LLC::allocate_line(CacheSet_t&, Addr_t) {
-  throw std::logic_error("LLC allocate_line called in passthrough mode.");
+size_t SimpleO3LLC::find_way(size_t set_base, Addr_t line) const {
+  for (size_t way = set_base; way < set_base + m_associativity; way++) {
+    if (m_tags[way] == line) {
+      return way;
+    }
+  }
+  return npos;
 }
 
-bool SimpleO3LLC::need_eviction(const CacheSet_t&, Addr_t) {
-  return false;
+size_t SimpleO3LLC::find_victim(size_t set_base) const {
+  size_t victim = npos;
+  for (size_t way = set_base; way < set_base + m_associativity; way++) {
+    if (!(m_states[way] & VALID)) {
+      return way;
+    }
+    if ((m_states[way] & READY) && (victim == npos || m_lru[way] < m_lru[victim])) {
+      victim = way;
+    }
+  }
+  return victim;
 }
 
-void SimpleO3LLC::evict_line(CacheSet_t&, CacheSet_t::iterator) {
-  // No-op
+void SimpleO3LLC::evict_line(size_t way) {
+  DEBUG_LOG(DSIMPLEO3LLC, m_logger, "Evicting {}.", m_tags[way] << m_line_offset);
+  s_llc_eviction++;
+
+  // Generate writeback request if victim line is dirty
+  if (m_states[way] & DIRTY) {
+    Request writeback_req(m_tags[way] << m_line_offset, Request::Type::Write);
+    schedule(m_miss_list, m_clk + m_latency, std::move(writeback_req));
+  }
+
+  m_tags[way] = -1;
+  m_states[way] = 0;
 }
 
-SimpleO3LLC::CacheSet_t::iterator SimpleO3LLC::check_set_hit(CacheSet_t&, Addr_t) {
-  return CacheSet_t::iterator();
+SimpleO3LLC::MSHREntry* SimpleO3LLC::find_mshr(int slice, Addr_t line) {
+  for (auto& mshr : m_slices[slice].mshrs) {
+    if (mshr.line == line) {
+      return &mshr;
+    }
+  }
+  return nullptr;
 }
 
-SimpleO3LLC::MSHR_t::iterator SimpleO3LLC::check_mshr_hit(Addr_t) {
-  return MSHR_t::iterator();
+void SimpleO3LLC::schedule(std::vector<PendingRequest>& list, Clk_t clk, Request req) {
+  list.push_back({clk, m_pending_seq++, std::move(req)});
+  std::push_heap(list.begin(), list.end(), PendingLater());
 }
 
-}  // namespace Ramulator
+}        // namespace Ramulator
@@ -2,15 +2,13 @@
 #define     RAMULATOR_FRONTEND_PROCESSOR_SIMPLEO3_LLC_H
 
 #include <vector>
-#include <list>
-#include <unordered_map>
-#include <iostream>
-#include <fstream>
+#include <cstdint>
 
 #include "base/clocked.h"
 #include "base/debug.h"
 #include "base/type.h"
 #include "base/request.h"
+#include "base/topology.h"
 #include "memory_system/memory_system.h"
 
 namespace Ramulator {
@@ -18,31 +16,72 @@ namespace Ramulator {
 DECLARE_DEBUG_FLAG(DSIMPLEO3LLC);
 // ENABLE_DEBUG_FLAG(DSIMPLEO3LLC);
 
+/**
+ * @brief    Shared, sliced LLC of the SimpleO3 processor.
+ *
+ * @details
+ * Cache lines are interleaved across the slices (slice = line address % #slices). Slice s sits at the ring/mesh stop
+ * of memory channel s of the NUMA topology, so a core reaches it after llc_latency plus the extra core-to-channel
+ * distance of that stop over the core's nearest one. Each slice has its own MSHRs.
+ *
+ * The tags, states and LRU stamps of all ways live in flat arrays indexed by (slice, set, way). A way is allocated
+ * when a miss is sent to memory and becomes ready when the fill returns, lines in flight are never evicted.
+ * Write misses allocate the line (marked dirty) and fetch it, dirty victims are written back.
+ *
+ * In bypass mode, requests go straight to the memory system with their original callback.
+ */
 class SimpleO3LLC : public Clocked<SimpleO3LLC> {
   friend class SimpleO3;
-  struct Line {
-    Addr_t addr = -1;
-    Addr_t tag = -1;
-    bool dirty = false;
-    bool ready = false;   // Whether this line is ready (i.e., is still inflight?)
-  };
 
   private:
-    using CacheSet_t = std::list<Line>;   // LRU queue for the set. The head of the list is the least-recently-used way.
-    std::unordered_map<int, CacheSet_t> m_cache_sets;
-    
-    using MSHREntry_t = std::pair<Addr_t, CacheSet_t::iterator>;
-    using MSHR_t = std::vector<MSHREntry_t>;
-    MSHR_t m_mshrs;
-    std::unordered_map<Addr_t, std::vector<Request>> m_receive_requests;
-
-    // Request that miss in the LLC with the clock cycle (current cycle + llc latency) that they 
-    // should be sent to the memory system
-    std::list<std::pair<Clk_t, Request>> m_miss_list;
-
-    // Request that hit in the LLC with the clock cycle (current cycle + llc latency) that they 
-    // should be sent back to the core (calls the callback)
-    std::list<std::pair<Clk_t, Request>> m_hit_list;
+    static constexpr size_t npos = -1;
+
+    // Line states
+    static constexpr uint8_t VALID = 1 << 0;
+    static constexpr uint8_t DIRTY = 1 << 1;
+    static constexpr uint8_t READY = 1 << 2;  // The line is not in flight
+
+    struct MSHREntry {
+      Addr_t line = -1;               // -1 if the entry is free
+      size_t way = 0;                 // Index of the allocated way in the flat arrays
+      std::vector<Request> requests;  // Reads waiting for the fill
+    };
+
+    struct Slice {
+      std::vector<MSHREntry> mshrs;
+      int num_mshrs_used = 0;
+    };
+
+    // Requests that are waiting for the latency of their slice
+    struct PendingRequest {
+      Clk_t clk;
+      uint64_t seq;
+      Request req;
+    };
+    struct PendingLater {
+      bool operator()(const PendingRequest& a, const PendingRequest& b) const {
+        return a.clk > b.clk || (a.clk == b.clk && a.seq > b.seq);
+      };
+    };
+
+    bool m_bypass = false;
+
+    std::vector<Addr_t>   m_tags;     // Line address of each way, -1 if invalid
+    std::vector<uint8_t>  m_states;
+    std::vector<uint64_t> m_lru;      // Stamp of the last access of each way, the smallest one is the LRU way
+    uint64_t m_lru_stamp = 0;
+
+    std::vector<Slice> m_slices;
+
+    std::vector<int> m_slice_latencies;   // Per core x slice
+
+    // Misses (and writebacks) that are sent to the memory system, and hits that are returned to the core, at clk
+    std::vector<PendingRequest> m_miss_list;
+    std::vector<PendingRequest> m_hit_list;
+    std::vector<PendingRequest> m_rejected;
+    uint64_t m_pending_seq = 0;
+
+    std::function<void(Request&)> m_fill_callback;
 
     IMemorySystem* m_memory_system;
 
@@ -55,12 +94,11 @@ class SimpleO3LLC : public Clocked<SimpleO3LLC> {
     size_t m_size_bytes;
     size_t m_linesize_bytes;
     int m_associativity;
-    int m_set_size;
     int m_num_mshrs;
+    int m_num_slices;
 
-    Addr_t m_index_mask;
-    int m_index_offset;
-    int m_tag_offset;
+    int m_sets_per_slice;
+    int m_line_offset;
 
 
     int s_llc_read_access = 0;
@@ -69,32 +107,39 @@ class SimpleO3LLC : public Clocked<SimpleO3LLC> {
     int s_llc_write_misses = 0;
     int s_llc_eviction = 0;
     int s_llc_mshr_unavailable = 0;
-    
+    int s_llc_set_unavailable = 0;
+
 
   public:
-    SimpleO3LLC(int latency, int size_bytes, int linesize_bytes, int associativity, int num_mshrs);
+    SimpleO3LLC(int latency, size_t size_bytes, int linesize_bytes, int associativity, int num_mshrs, int num_slices, bool bypass);
     void connect_memory_system(IMemorySystem* memory_system) { m_memory_system = memory_system; };
-    
+
+    /**
+     * @brief    Sets the latency from each core to each slice from the topology.
+     *
+     * @param cycles_per_distance   LLC cycles per memory cycle of topology distance
+     */
+    void set_slice_latencies(const NUMATopology& topology, int num_cores, double cycles_per_distance);
+
     void tick();
     bool send(Request req);
     void receive(Request& req);
 
-    void serialize(std::string serialization_filename);
-    void deserialize(std::string serialization_filename);
-    void dump_llc();
-
   private:
-    int get_index(Addr_t addr)  { return (addr >> m_index_offset) & m_index_mask; };
-    Addr_t get_tag(Addr_t addr) { return (addr >> m_tag_offset); };
-    Addr_t align(Addr_t addr)   { return (addr & ~(m_linesize_bytes-1l)); };
-
-    CacheSet_t& get_set(Addr_t addr);
-    CacheSet_t::iterator allocate_line(CacheSet_t& set, Addr_t addr);
-    bool need_eviction(const CacheSet_t& set, Addr_t addr);
-    void evict_line(CacheSet_t& set, CacheSet_t::iterator victim_it);
-
-    CacheSet_t::iterator check_set_hit(CacheSet_t& set, Addr_t addr);
-    MSHR_t::iterator check_mshr_hit(Addr_t addr);
+    Addr_t get_line(Addr_t addr) const { return addr >> m_line_offset; };
+    int get_slice(Addr_t line) const { return line % m_num_slices; };
+    size_t get_set_base(Addr_t line, int slice) const {
+      return (size_t(slice) * m_sets_per_slice + (line / m_num_slices) % m_sets_per_slice) * m_associativity;
+    };
+    int get_latency(int core, int slice) const;
+    void count_access(bool is_write, bool is_miss);
+
+    size_t find_way(size_t set_base, Addr_t line) const;
+    size_t find_victim(size_t set_base) const;
+    void evict_line(size_t way);
+    MSHREntry* find_mshr(int slice, Addr_t line);
+
+    void schedule(std::vector<PendingRequest>& list, Clk_t clk, Request req);
 };
 
 }        // namespace Ramulator
@@ -1,6 +1,7 @@
 #include <functional>
 
 #include "base/utils.h"
+#include "base/topology.h"
 #include "frontend/frontend.h"
 #include "translation/translation.h"
 #include "frontend/impl/processor/simpleO3/core.h"
@@ -18,6 +19,7 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
     int m_num_cores = -1;
     std::vector<SimpleO3Core*> m_cores;
     SimpleO3LLC* m_llc;
+    float m_llc_latency_scale = 1.0f;
 
     size_t m_num_expected_insts = 0;
 
@@ -34,6 +36,8 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
 
       int ipc   = param<int>("ipc").desc("IPC of the SimpleO3 core.").default_val(4);
       int depth = param<int>("inst_window_depth").desc("Instruction window size of the SimpleO3 core.").default_val(128);
+      int lq_size = param<int>("load_queue_size").desc("Number of loads in the instruction window of a core (0: limited by the window only).").default_val(0);
+      int sq_size = param<int>("store_queue_size").desc("Number of writebacks that wait for the LLC in a core (0: a rejected writeback stalls the core).").default_val(0);
 
       // LLC params
       int llc_latency           = param<int>("llc_latency").desc("Aggregated latency of the LLC.").default_val(47);
@@ -41,6 +45,9 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
       int llc_associativity     = param<int>("llc_associativity").desc("LLC set associativity.").default_val(8);
       int llc_capacity_per_core = parse_capacity_str(param<std::string>("llc_capacity_per_core").desc("LLC capacity per core.").default_val("2MB"));
       int llc_num_mshr_per_core = param<int>("llc_num_mshr_per_core").desc("Number of LLC MSHR entries per core.").default_val(16);
+      int llc_num_slices        = param<int>("llc_num_slices").desc("Number of LLC slices (defaults to one per memory channel of the topology).").default_val(numa_topology.get_num_channels());
+      m_llc_latency_scale       = param<float>("llc_latency_scale").desc("Multiplier on the topology distance from a core to a remote LLC slice.").default_val(1.0f);
+      bool llc_bypass           = param<bool>("llc_bypass").desc("Send all requests directly to the memory system.").default_val(false);
 
       // Simulation parameters
       m_num_expected_insts = param<int>("num_expected_insts").desc("Number of instructions that the frontend should execute.").required();
@@ -49,13 +56,11 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
       m_translation = create_child_ifce<ITranslation>();
 
       // Create the LLC
-      m_llc = new SimpleO3LLC(llc_latency, llc_capacity_per_core * m_num_cores, llc_linesize_bytes, llc_associativity, llc_num_mshr_per_core * m_num_cores);
-      // m_llc->deserialize(serialization_filename);
-      // m_llc->serialize(serialization_filename);
+      m_llc = new SimpleO3LLC(llc_latency, size_t(llc_capacity_per_core) * m_num_cores, llc_linesize_bytes, llc_associativity, llc_num_mshr_per_core * m_num_cores, llc_num_slices, llc_bypass);
 
       // Create the cores
       for (int id = 0; id < m_num_cores; id++) {
-        SimpleO3Core* core = new SimpleO3Core(id, ipc, depth, m_num_expected_insts, trace_list[id], m_translation, m_llc);
+        SimpleO3Core* core = new SimpleO3Core(id, ipc, depth, lq_size, sq_size, m_num_expected_insts, trace_list[id], m_translation, m_llc);
         core->m_callback = [this](Request& req){return this->receive(req);} ;
         m_cores.push_back(core);
       }
@@ -70,11 +75,16 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
       register_stat(m_llc->s_llc_read_misses).name("llc_read_misses");
       register_stat(m_llc->s_llc_write_misses).name("llc_write_misses");
       register_stat(m_llc->s_llc_mshr_unavailable).name("llc_mshr_unavailable");
+      register_stat(m_llc->s_llc_set_unavailable).name("llc_set_unavailable");
       
       for (int core_id = 0; core_id < m_cores.size(); core_id++) {
         // register_stat(m_cores[core_id]->s_insts_retired).name("cycles_retired_core_{}", core_id);
         register_stat(m_cores[core_id]->s_cycles_recorded).name("cycles_recorded_core_{}", core_id);
         register_stat(m_cores[core_id]->s_mem_access_cycles).name("memory_access_cycles_recorded_core_{}", core_id);
+        register_stat(m_cores[core_id]->s_avg_mlp).name("avg_mlp_core_{}", core_id);
+        register_stat(m_cores[core_id]->s_mlp_cycles).name("mlp_cycles_core_{}", core_id);
+        register_stat(m_cores[core_id]->s_lq_full_cycles).name("load_queue_full_cycles_core_{}", core_id);
+        register_stat(m_cores[core_id]->s_sq_full_cycles).name("store_queue_full_cycles_core_{}", core_id);
       }
     }
 
@@ -85,6 +95,7 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
         m_logger->info("Processor Heartbeat {} cycles.", m_clk);
       }
 
+      m_translation->tick();
       m_llc->tick();
       for (auto core : m_cores) {
         core->tick();
@@ -104,8 +115,19 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
       return true;
     }
 
+    void finalize() override {
+      for (auto core : m_cores) {
+        core->finalize();
+      }
+      IFrontEnd::finalize();
+    }
+
     void connect_memory_system(IMemorySystem* memory_system) override {
+      IFrontEnd::connect_memory_system(memory_system);
       m_llc->connect_memory_system(memory_system);
+      // Topology distances are in memory cycles
+      double cycles_per_mem_cycle = double(m_clock_ratio) / memory_system->get_clock_ratio();
+      m_llc->set_slice_latencies(numa_topology, m_num_cores, m_llc_latency_scale * cycles_per_mem_cycle);
     };
 
     int get_num_cores() override {
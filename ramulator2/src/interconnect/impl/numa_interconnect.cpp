@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "base/topology.h"
+#include "interconnect/interconnect.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Point-to-point links between every core and every channel.
+ *
+ * @details
+ * A request travels over the link from its core to its channel for the core-to-channel NUMA distance, waits in the
+ * ingress queue of the channel until the controller accepts it, and the response travels back over the reverse link
+ * before the requester's callback fires. Each link injects at most link_bandwidth packets per cycle, and a full
+ * ingress queue rejects new requests, so a congested channel back-pressures the frontend.
+ *
+ * Requests whose source is not a core (e.g., source_id == -1) are delivered without any delay.
+ */
+class NUMAInterconnect final : public IInterconnect, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IInterconnect, NUMAInterconnect, "NUMA", "Core-to-channel links with NUMA hop latencies and per-link bandwidth.");
+
+  private:
+    struct Packet {
+      Clk_t arrive;     // Cycle at which the packet reaches the other end of its link
+      uint64_t seq;     // Injection order, breaks ties between packets arriving in the same cycle
+      Clk_t sent;       // Cycle at which the packet entered the interconnect
+      Request req;
+    };
+    struct ArrivesLater {
+      bool operator()(const Packet& a, const Packet& b) const {
+        return a.arrive != b.arrive ? a.arrive > b.arrive : a.seq > b.seq;
+      }
+    };
+    // Binary heaps ordered by arrival (std::priority_queue does not let us retry or move out the top element)
+    using PacketHeap = std::vector<Packet>;
+
+    float m_latency_scale = 1.0f;
+    double m_link_interval = 1.0;    // Cycles a link is occupied by one packet
+    size_t m_buffer_size = 32;
+
+    int m_num_cores = 0;
+    int m_num_channels = 0;
+
+    std::vector<PacketHeap> m_request_queues;   // Per channel, requests in flight to or waiting at the controller
+    PacketHeap m_response_queue;
+    std::vector<double> m_request_link_free;    // Per core x channel, the cycle from which the link can inject again
+    std::vector<double> m_response_link_free;   // Per channel x core
+    uint64_t m_seq = 0;
+
+    size_t s_num_requests = 0;
+    size_t s_num_rejections = 0;
+    size_t s_num_responses = 0;
+    size_t s_request_latency = 0;
+    size_t s_response_latency = 0;
+    size_t s_read_latency = 0;
+    float s_avg_request_latency = 0;
+    float s_avg_response_latency = 0;
+
+  public:
+    void init() override {
+      m_latency_scale = param<float>("latency_scale").desc("Scales the core-to-channel distances (in memory cycles) into hop latencies.").default_val(1.0f);
+      float link_bandwidth = param<float>("link_bandwidth").desc("Packets per memory cycle each core-to-channel link can carry.").default_val(1.0f);
+      m_buffer_size = param<size_t>("buffer_size").desc("Requests each channel can have in flight or waiting for its controller.").default_val(32);
+
+      if (link_bandwidth <= 0.0f) {
+        throw ConfigurationError("Interconnect link_bandwidth must be positive!");
+      }
+      m_link_interval = 1.0 / link_bandwidth;
+
+      register_stat(s_num_requests).name("interconnect_num_requests");
+      register_stat(s_num_rejections).name("interconnect_num_rejections");
+      register_stat(s_num_responses).name("interconnect_num_responses");
+      register_stat(s_avg_request_latency).name("interconnect_avg_request_latency");
+      register_stat(s_avg_response_latency).name("interconnect_avg_response_latency");
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_num_cores = numa_topology.get_num_cores();
+      m_num_channels = m_controllers.size();
+      if (m_num_channels != numa_topology.get_num_channels()) {
+        throw ConfigurationError("The Topology has {} channels but the memory system has {}!", numa_topology.get_num_channels(), m_num_channels);
+      }
+      m_request_queues.resize(m_num_channels);
+      m_request_link_free.resize(m_num_cores * m_num_channels, 0.0);
+      m_response_link_free.resize(m_num_channels * m_num_cores, 0.0);
+    };
+
+    bool send(Request& req) override {
+      int channel = req.addr_vec[0];
+      int core = req.source_id;
+      auto& queue = m_request_queues[channel];
+
+      if (queue.size() >= m_buffer_size) {
+        s_num_rejections++;
+        return false;
+      }
+
+      if (req.callback) {
+        // Hold the response back until it has travelled to the requester
+        auto callback = req.callback;
+        req.callback = [this, callback](Request& r) { respond(r, callback); };
+      }
+
+      if (!is_core(core)) {
+        return deliver_now(req, queue);
+      }
+
+      double& link_free = m_request_link_free[core * m_num_channels + channel];
+      int latency = hop_latency(core, channel);
+      if (latency == 0 && link_free <= m_clk) {
+        if (!deliver_now(req, queue)) {
+          return false;
+        }
+        link_free = m_clk + m_link_interval;
+        return true;
+      }
+
+      Clk_t arrive = inject(link_free, latency);
+      queue.push_back({arrive, m_seq++, m_clk, req});
+      std::push_heap(queue.begin(), queue.end(), ArrivesLater());
+      return true;
+    };
+
+    void tick() override {
+      m_clk++;
+
+      // Hand the requests that reached their channel to the controller, in arrival order
+      for (int channel = 0; channel < m_num_channels; channel++) {
+        auto& queue = m_request_queues[channel];
+        while (!queue.empty() && queue.front().arrive <= m_clk) {
+          Packet& packet = queue.front();
+          if (!m_controllers[channel]->send(packet.req)) {
+            // The controller is full, everything behind this request has to wait as well
+            break;
+          }
+          account_request(packet.req, packet.sent);
+          std::pop_heap(queue.begin(), queue.end(), ArrivesLater());
+          queue.pop_back();
+        }
+      }
+
+      // Complete the responses that reached their requester
+      while (!m_response_queue.empty() && m_response_queue.front().arrive <= m_clk) {
+        std::pop_heap(m_response_queue.begin(), m_response_queue.end(), ArrivesLater());
+        Packet packet = std::move(m_response_queue.back());
+        m_response_queue.pop_back();
+        complete(packet.req, m_clk - packet.sent);
+      }
+    };
+
+    Clk_t get_num_idle_ticks() override {
+      // Nothing happens until the next packet reaches the end of its link
+      Clk_t next_arrival = std::numeric_limits<Clk_t>::max();
+      for (const auto& queue : m_request_queues) {
+        if (!queue.empty()) {
+          next_arrival = std::min(next_arrival, queue.front().arrive);
+        }
+      }
+      if (!m_response_queue.empty()) {
+        next_arrival = std::min(next_arrival, m_response_queue.front().arrive);
+      }
+      if (next_arrival == std::numeric_limits<Clk_t>::max()) {
+        return next_arrival;
+      }
+      return std::max(next_arrival - m_clk - 1, (Clk_t)0);
+    };
+
+    void finalize() override {
+      s_avg_request_latency = s_num_requests ? (float)s_request_latency / (float)s_num_requests : 0.0f;
+      s_avg_response_latency = s_num_responses ? (float)s_response_latency / (float)s_num_responses : 0.0f;
+      // Reads spend this time on top of their controller latency
+      overall_latency += s_read_latency;
+    };
+
+  private:
+    bool is_core(int source_id) const { return source_id >= 0 && source_id < m_num_cores; };
+
+    int hop_latency(int core, int channel) const {
+      return std::lround(m_latency_scale * numa_topology.get_latency(core, channel));
+    };
+
+    Clk_t inject(double& link_free, int latency) {
+      double start = std::max((double)m_clk, link_free);
+      link_free = start + m_link_interval;
+      return (Clk_t)std::ceil(start) + latency;
+    };
+
+    bool deliver_now(Request& req, PacketHeap& queue) {
+      // Only bypass the ingress queue if nothing that arrived earlier is still waiting in it
+      if (!queue.empty() && queue.front().arrive <= m_clk) {
+        return false;
+      }
+      int channel = req.addr_vec[0];
+      if (!m_controllers[channel]->send(req)) {
+        return false;
+      }
+      account_request(req, m_clk);
+      return true;
+    };
+
+    void account_request(const Request& req, Clk_t sent) {
+      s_num_requests++;
+      s_request_latency += m_clk - sent;
+      if (req.type_id == Request::Type::Read) {
+        s_read_latency += m_clk - sent;
+      }
+    };
+
+    void respond(Request& req, const std::function<void(Request&)>& callback) {
+      Request resp = req;
+      resp.callback = callback;
+
+      int core = req.source_id;
+      int channel = req.addr_vec[0];
+      if (!is_core(core)) {
+        complete(resp, 0);
+        return;
+      }
+
+      Clk_t arrive = inject(m_response_link_free[channel * m_num_cores + core], hop_latency(core, channel));
+      if (arrive <= m_clk) {
+        complete(resp, 0);
+        return;
+      }
+      m_response_queue.push_back({arrive, m_seq++, m_clk, resp});
+      std::push_heap(m_response_queue.begin(), m_response_queue.end(), ArrivesLater());
+    };
+
+    void complete(Request& resp, Clk_t latency) {
+      s_num_responses++;
+      s_response_latency += latency;
+      if (resp.type_id == Request::Type::Read) {
+        s_read_latency += latency;
+      }
+      resp.callback(resp);
+    };
+};
+
+}       // namespace Ramulator
@@ -0,0 +1,39 @@
+#ifndef RAMULATOR_INTERCONNECT_INTERCONNECT_H
+#define RAMULATOR_INTERCONNECT_INTERCONNECT_H
+
+#include <vector>
+
+#include <spdlog/spdlog.h>
+#include <yaml-cpp/yaml.h>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+
+namespace Ramulator {
+
+class IInterconnect : public Clocked<IInterconnect> {
+  RAMULATOR_REGISTER_INTERFACE(IInterconnect, "Interconnect", "Interconnect between the requesters (cores) and the memory controllers.");
+
+  public:
+    std::vector<IDRAMController*> m_controllers;    // Set by the memory system, indexed by channel id
+
+  public:
+    /**
+     * @brief    Tries to accept a request (with its addr_vec already mapped) for delivery to the controller of its channel.
+     *
+     * @return   true       The request is in flight, its callback (if any) fires once the response has travelled back.
+     * @return   false      The interconnect is full (e.g., the channel is congested), retry later.
+     */
+    virtual bool send(Request& req) = 0;
+
+    /**
+     * @brief    Ticks the interconnect: delivers requests that arrived at their controllers and responses that
+     *           arrived at their requesters. Called by the memory system before the controllers are ticked.
+     *
+     */
+    virtual void tick() = 0;
+};
+
+}       // namespace Ramulator
+
+#endif  // RAMULATOR_INTERCONNECT_INTERCONNECT_H
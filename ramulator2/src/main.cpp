@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 
 #include <argparse/argparse.hpp>
@@ -6,6 +7,7 @@
 
 #include "base/base.h"
 #include "base/config.h"
+#include "base/topology.h"
 #include "frontend/frontend.h"
 #include "memory_system/memory_system.h"
 #include "example/example_ifce.h"
@@ -20,6 +22,8 @@ int main(int argc, char* argv[]) {
   program.add_argument("-p", "--param").metavar("KEY=VALUE")
     .append()
     .help("Specify parameter to override in the configuration file. Repeat this option to change multiple parameters.");
+  program.add_argument("--no_cycle_skipping").default_value(false).implicit_value(true)
+    .help("Tick the frontend and the memory system every cycle instead of jumping over idle cycles.");
 
   try {
     program.parse_args(argc, argv);
@@ -78,7 +82,8 @@ int main(int argc, char* argv[]) {
     config = Ramulator::Config::parse_config_file(config_file_path, params);
   }
 
-  Ramulator::initialize_core_channel_latency();
+  // Set up the core-to-channel distances before any component that queries them is created
+  Ramulator::numa_topology.init(config["Topology"]);
 
   // Instaniate the frontend of the simulated system, this is one of the top-level objects in Ramulator 2.0.
   // It also recursively instaniate all components in the frontend.
@@ -99,6 +104,10 @@ int main(int argc, char* argv[]) {
 
   int tick_mult = frontend_tick * mem_tick;
 
+  bool skip_cycles = !program.get<bool>("--no_cycle_skipping");
+  // Caps the reported idle ticks so that the index arithmetic below cannot overflow
+  const uint64_t max_idle_ticks = uint64_t(1) << 40;
+
   for (uint64_t i = 0;; i++) {
     if (((i % tick_mult) % mem_tick) == 0) {
       frontend->tick();
@@ -111,6 +120,31 @@ int main(int argc, char* argv[]) {
     if ((i % tick_mult) % frontend_tick == 0) {
       memory_system->tick();
     }
+
+    if (!skip_cycles) {
+      continue;
+    }
+
+    // Jump to the next iteration at which either side may do work. The skipped ticks would only have advanced the
+    // clocks and the per-cycle statistics, which skip_idle_ticks() accounts for in bulk.
+    uint64_t fe_idle = std::min<uint64_t>(std::max<Ramulator::Clk_t>(frontend->get_num_idle_ticks(), 0), max_idle_ticks);
+    uint64_t next_fe = (i / mem_tick + 1 + fe_idle) * mem_tick;
+    if (next_fe == i + 1) {
+      continue;
+    }
+    uint64_t mem_idle = std::min<uint64_t>(std::max<Ramulator::Clk_t>(memory_system->get_num_idle_ticks(), 0), max_idle_ticks);
+    uint64_t next_mem = (i / frontend_tick + 1 + mem_idle) * frontend_tick;
+    uint64_t target = std::min(next_fe, next_mem);
+
+    uint64_t num_fe_ticks = (target - 1) / mem_tick - i / mem_tick;
+    uint64_t num_mem_ticks = (target - 1) / frontend_tick - i / frontend_tick;
+    if (num_fe_ticks > 0) {
+      frontend->skip_idle_ticks(num_fe_ticks);
+    }
+    if (num_mem_ticks > 0) {
+      memory_system->skip_idle_ticks(num_mem_ticks);
+    }
+    i = target - 1;
   }
 
   // Finalize the simulation. Recursively print all statistics from all components
@@ -1,7 +1,14 @@
+#include <algorithm>
+#include <barrier>
+#include <deque>
+#include <memory>
+#include <thread>
+
 #include "memory_system/memory_system.h"
 #include "translation/translation.h"
 #include "dram_controller/controller.h"
 #include "addr_mapper/addr_mapper.h"
+#include "interconnect/interconnect.h"
 #include "dram/dram.h"
 #include "base/utils.h"
 
@@ -17,6 +24,45 @@ namespace Ramulator
         IDRAM *m_dram;
         IAddrMapper *m_addr_mapper;
         std::vector<IDRAMController *> m_controllers;
+        IInterconnect *m_interconnect = nullptr; // Optional, requests go straight to the controllers without it
+
+        /**
+         * Parallel mode (num_threads > 1): every channel gets its own device model instance, so that a controller
+         * and its DRAM only ever touch their own state. Requests sent by the frontend wait in the channel's inbox,
+         * and every quantum cycles the worker threads catch all channels up to the memory system clock, handing
+         * each request to its controller at the cycle it was sent. The reads served during the quantum are reported
+         * back at the end of the quantum, ordered by cycle and then by channel, so the results do not depend on
+         * the number of threads or on their timing.
+         */
+        struct Arrival
+        {
+            Clk_t clk; // The memory system cycle at which the request was sent
+            Request req;
+        };
+        struct Completion
+        {
+            Clk_t clk; // The cycle in which the controller served the request
+            Request req;
+        };
+        struct Channel
+        {
+            IDRAM *dram = nullptr;
+            IDRAMController *controller = nullptr;
+            Clk_t clk = 0;                       // Cycles simulated so far
+            std::deque<Arrival> inbox;           // Only touched by the main thread between quanta
+            std::vector<Completion> completions; // Only touched by the channel's worker during a quantum
+        };
+        int m_num_threads = 1;
+        Clk_t m_quantum = 0;
+        size_t m_inbox_size = 0;
+        std::vector<Channel> m_channels;
+        Clk_t m_synced_clk = 0; // The last multiple of m_quantum, all channels are caught up to it
+        std::vector<Completion> m_completions;
+
+        std::vector<std::thread> m_workers;
+        std::unique_ptr<std::barrier<>> m_start_barrier;
+        std::unique_ptr<std::barrier<>> m_done_barrier;
+        bool m_stop_workers = false;
 
     public:
         int s_num_read_requests = 0;
@@ -42,15 +88,78 @@ namespace Ramulator
                 m_controllers.push_back(controller);
             }
 
+            if (m_config["Interconnect"])
+            {
+                m_interconnect = create_child_ifce<IInterconnect>();
+                m_interconnect->m_controllers = m_controllers;
+            }
+
             m_clock_ratio = param<uint>("clock_ratio").required();
 
+            m_num_threads = param<int>("num_threads").desc("Number of threads simulating the channels in parallel, 1 ticks all channels serially every cycle.").default_val(1);
+            m_quantum = param<Clk_t>("quantum").desc("Number of cycles between two synchronizations of the channel threads (only with num_threads > 1).").default_val(64);
+            m_inbox_size = param<size_t>("inbox_size").desc("Number of requests per channel that can wait for the next quantum before send() rejects (only with num_threads > 1).").default_val(64);
+            m_num_threads = std::min(m_num_threads, num_channels);
+            if (m_num_threads > 1)
+            {
+                if (m_interconnect)
+                {
+                    throw ConfigurationError("The Interconnect cannot be used with num_threads > 1, its links are shared by all channels!");
+                }
+                if (m_quantum <= 0)
+                {
+                    throw ConfigurationError("The quantum ({}) must be positive!", m_quantum);
+                }
+
+                m_channels.resize(num_channels);
+                for (int i = 0; i < num_channels; i++)
+                {
+                    IDRAM *dram = (i == 0) ? m_dram : create_child_ifce<IDRAM>();
+                    dram->m_impl->set_id(fmt::format("Channel {}", i));
+                    // Picked up by the controller (and through it, its scheduler, refresh manager, and plugins) in setup()
+                    m_controllers[i]->m_dram = dram;
+                    m_channels[i].dram = dram;
+                    m_channels[i].controller = m_controllers[i];
+                }
+            }
+
             register_stat(m_clk).name("memory_system_cycles");
             register_stat(s_num_read_requests).name("total_num_read_requests");
             register_stat(s_num_write_requests).name("total_num_write_requests");
             register_stat(s_num_other_requests).name("total_num_other_requests");
         };
 
-        void setup(IFrontEnd *frontend, IMemorySystem *memory_system) override {}
+        void setup(IFrontEnd *frontend, IMemorySystem *memory_system) override
+        {
+            if (m_num_threads > 1)
+            {
+                // The main thread simulates its share of the channels as well
+                m_start_barrier = std::make_unique<std::barrier<>>(m_num_threads);
+                m_done_barrier = std::make_unique<std::barrier<>>(m_num_threads);
+                for (int thread_id = 1; thread_id < m_num_threads; thread_id++)
+                {
+                    m_workers.emplace_back(&CustomDRAMSystem::worker, this, thread_id);
+                }
+            }
+        }
+
+        ~CustomDRAMSystem()
+        {
+            stop_workers();
+        }
+
+        void finalize() override
+        {
+            if (m_num_threads > 1)
+            {
+                if (m_clk > m_synced_clk)
+                {
+                    run_quantum();
+                }
+                stop_workers();
+            }
+            IMemorySystem::finalize();
+        }
 
         bool send(Request req) override
         {
@@ -58,7 +167,8 @@ namespace Ramulator
             Addr_t vpn = req.v_addr >> 12; // Extract VPN from address
             vpn_access_counts[vpn]++;      // Increment access count for this VPN
 
-            if (is_in_top_cache(vpn))
+            // Requests that did not go through a translation (e.g., from the Sniper or GEM5 frontends) have no VPN
+            if (req.v_addr != -1 && is_in_top_cache(vpn))
             {
                 DEBUG_LOG(DTRANSLATE, m_logger, "VPN {} is in top cache; skipping translation.", vpn);
                 total_cache_req++;
@@ -89,7 +199,15 @@ namespace Ramulator
 
             m_addr_mapper->apply(req);
             int channel_id = req.addr_vec[0];
-            bool is_success = m_controllers[channel_id]->send(req);
+            bool is_success;
+            if (m_num_threads > 1)
+            {
+                is_success = send_to_inbox(m_channels[channel_id], req);
+            }
+            else
+            {
+                is_success = m_interconnect ? m_interconnect->send(req) : m_controllers[channel_id]->send(req);
+            }
 
             if (is_success)
             {
@@ -116,16 +234,106 @@ namespace Ramulator
             return is_success;
         };
 
+        bool copy_send(Request &req) override
+        {
+            if (m_num_threads > 1)
+            {
+                return false;
+            }
+            m_addr_mapper->apply(req);
+            return m_controllers[req.addr_vec[0]]->copy_send(req);
+        };
+
+        bool accepts_copy_requests() override
+        {
+            // The controllers are ticked by the worker threads, which only take requests through the inboxes
+            if (m_num_threads > 1)
+            {
+                return false;
+            }
+            return std::all_of(m_controllers.begin(), m_controllers.end(), [](IDRAMController *controller)
+                               { return controller->accepts_copy_requests(); });
+        };
+
         void tick() override
         {
             m_clk++;
+            if (m_num_threads > 1)
+            {
+                if (m_clk % m_quantum == 0)
+                {
+                    run_quantum();
+                }
+                return;
+            }
+
             m_dram->tick();
+            if (m_interconnect)
+            {
+                m_interconnect->tick();
+            }
             for (auto controller : m_controllers)
             {
                 controller->tick();
             }
         };
 
+        Clk_t get_num_idle_ticks() override
+        {
+            if (m_num_threads > 1)
+            {
+                // Nothing is reported back before the end of a quantum, and the quanta before the first cycle in which
+                // any channel (still at m_synced_clk) may do work can be skipped altogether
+                Clk_t num_channel_idle_ticks = 0;
+                if (std::all_of(m_channels.begin(), m_channels.end(), [](const Channel &channel)
+                                { return channel.inbox.empty(); }))
+                {
+                    num_channel_idle_ticks = Clk_t(1) << 40;
+                    for (auto &channel : m_channels)
+                    {
+                        num_channel_idle_ticks = std::min({num_channel_idle_ticks, channel.dram->get_num_idle_ticks(), channel.controller->get_num_idle_ticks()});
+                    }
+                }
+                Clk_t next_active = std::max(m_synced_clk + num_channel_idle_ticks + 1, m_clk + 1);
+                Clk_t next_sync = (next_active + m_quantum - 1) / m_quantum * m_quantum;
+                return next_sync - m_clk - 1;
+            }
+
+            Clk_t num_idle_ticks = m_dram->get_num_idle_ticks();
+            if (m_interconnect)
+            {
+                num_idle_ticks = std::min(num_idle_ticks, m_interconnect->get_num_idle_ticks());
+            }
+            for (auto controller : m_controllers)
+            {
+                if (num_idle_ticks == 0)
+                {
+                    break;
+                }
+                num_idle_ticks = std::min(num_idle_ticks, controller->get_num_idle_ticks());
+            }
+            return num_idle_ticks;
+        };
+
+        void skip_idle_ticks(Clk_t n) override
+        {
+            m_clk += n;
+            if (m_num_threads > 1)
+            {
+                return;
+            }
+
+            m_dram->skip_idle_ticks(n);
+            if (m_interconnect)
+            {
+                m_interconnect->skip_idle_ticks(n);
+            }
+            for (auto controller : m_controllers)
+            {
+                controller->skip_idle_ticks(n);
+            }
+        };
+
         float get_tCK() override
         {
             return m_dram->m_timing_vals("tCK_ps") / 1000.0f;
@@ -181,6 +389,123 @@ namespace Ramulator
             }
             return false;
         }
+
+    private:
+        bool send_to_inbox(Channel &channel, Request &req)
+        {
+            if (channel.inbox.size() >= m_inbox_size)
+            {
+                return false;
+            }
+            if (req.callback)
+            {
+                // Defer the callback to the end of the quantum, it must not run on the worker thread
+                Channel *ch = &channel;
+                req.callback = [ch, callback = std::move(req.callback)](Request &served)
+                {
+                    Request resp = served;
+                    resp.callback = callback;
+                    ch->completions.push_back({ch->clk, std::move(resp)});
+                };
+            }
+            channel.inbox.push_back({m_clk, req});
+            return true;
+        }
+
+        /**
+         * @brief    Simulates the channel up to (and including) cycle target.
+         */
+        void run_channel(Channel &channel, Clk_t target)
+        {
+            while (channel.clk < target)
+            {
+                // Hand over the requests sent up to now in order, the rest of the inbox waits if the controller is full
+                auto &inbox = channel.inbox;
+                while (!inbox.empty() && inbox.front().clk <= channel.clk && channel.controller->send(inbox.front().req))
+                {
+                    inbox.pop_front();
+                }
+
+                Clk_t num_idle_ticks = std::min({target - channel.clk, channel.dram->get_num_idle_ticks(), channel.controller->get_num_idle_ticks()});
+                if (!inbox.empty())
+                {
+                    num_idle_ticks = std::min(num_idle_ticks, std::max(inbox.front().clk - channel.clk, (Clk_t)0));
+                }
+                if (num_idle_ticks > 0)
+                {
+                    channel.clk += num_idle_ticks;
+                    channel.dram->skip_idle_ticks(num_idle_ticks);
+                    channel.controller->skip_idle_ticks(num_idle_ticks);
+                }
+                else
+                {
+                    channel.clk++;
+                    channel.dram->tick();
+                    channel.controller->tick();
+                }
+            }
+        }
+
+        void run_channels(int thread_id)
+        {
+            for (size_t i = thread_id; i < m_channels.size(); i += m_num_threads)
+            {
+                run_channel(m_channels[i], m_clk);
+            }
+        }
+
+        void worker(int thread_id)
+        {
+            while (true)
+            {
+                m_start_barrier->arrive_and_wait();
+                if (m_stop_workers)
+                {
+                    return;
+                }
+                run_channels(thread_id);
+                m_done_barrier->arrive_and_wait();
+            }
+        }
+
+        void stop_workers()
+        {
+            if (m_workers.empty())
+            {
+                return;
+            }
+            m_stop_workers = true;
+            m_start_barrier->arrive_and_wait();
+            for (auto &worker : m_workers)
+            {
+                worker.join();
+            }
+            m_workers.clear();
+        }
+
+        /**
+         * @brief    Catches all channels up to the memory system clock, then reports the served reads.
+         */
+        void run_quantum()
+        {
+            m_start_barrier->arrive_and_wait();
+            run_channels(0);
+            m_done_barrier->arrive_and_wait();
+            m_synced_clk = m_clk;
+
+            m_completions.clear();
+            for (auto &channel : m_channels)
+            {
+                std::move(channel.completions.begin(), channel.completions.end(), std::back_inserter(m_completions));
+                channel.completions.clear();
+            }
+            std::stable_sort(m_completions.begin(), m_completions.end(), [](const Completion &a, const Completion &b)
+                             { return a.clk < b.clk; });
+            for (auto &completion : m_completions)
+            {
+                completion.req.callback(completion.req);
+            }
+        }
     };
 
 } // namespace
@@ -1,3 +1,5 @@
+#include <limits>
+
 #include "memory_system/memory_system.h"
 
 namespace Ramulator {
@@ -18,6 +20,10 @@ class DummyMemorySystem final : public IMemorySystem, public Implementation {
     };
 
     void tick() override {};
+
+    Clk_t get_num_idle_ticks() override { return std::numeric_limits<Clk_t>::max(); };
+
+    void skip_idle_ticks(Clk_t n) override {};
 };
   
 }   // namespace Ramulator
\ No newline at end of file
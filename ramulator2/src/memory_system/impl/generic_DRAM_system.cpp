@@ -1,7 +1,10 @@
+#include <algorithm>
+
 #include "memory_system/memory_system.h"
 #include "translation/translation.h"
 #include "dram_controller/controller.h"
 #include "addr_mapper/addr_mapper.h"
+#include "interconnect/interconnect.h"
 #include "dram/dram.h"
 
 namespace Ramulator {
@@ -14,6 +17,7 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
     IDRAM*  m_dram;
     IAddrMapper*  m_addr_mapper;
     std::vector<IDRAMController*> m_controllers;
+    IInterconnect* m_interconnect = nullptr;    // Optional, requests go straight to the controllers without it
 
   public:
     int s_num_read_requests = 0;
@@ -37,6 +41,11 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
         m_controllers.push_back(controller);
       }
 
+      if (m_config["Interconnect"]) {
+        m_interconnect = create_child_ifce<IInterconnect>();
+        m_interconnect->m_controllers = m_controllers;
+      }
+
       m_clock_ratio = param<uint>("clock_ratio").required();
 
       register_stat(m_clk).name("memory_system_cycles");
@@ -50,7 +59,7 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
     bool send(Request req) override {
       m_addr_mapper->apply(req);
       int channel_id = req.addr_vec[0];
-      bool is_success = m_controllers[channel_id]->send(req);
+      bool is_success = m_interconnect ? m_interconnect->send(req) : m_controllers[channel_id]->send(req);
 
       if (is_success) {
         switch (req.type_id) {
@@ -71,15 +80,52 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
 
       return is_success;
     };
+
+    bool copy_send(Request& req) override {
+      m_addr_mapper->apply(req);
+      return m_controllers[req.addr_vec[0]]->copy_send(req);
+    };
+
+    bool accepts_copy_requests() override {
+      return std::all_of(m_controllers.begin(), m_controllers.end(), [](IDRAMController* controller) { return controller->accepts_copy_requests(); });
+    };
     
     void tick() override {
       m_clk++;
       m_dram->tick();
+      if (m_interconnect) {
+        m_interconnect->tick();
+      }
       for (auto controller : m_controllers) {
         controller->tick();
       }
     };
 
+    Clk_t get_num_idle_ticks() override {
+      Clk_t num_idle_ticks = m_dram->get_num_idle_ticks();
+      if (m_interconnect) {
+        num_idle_ticks = std::min(num_idle_ticks, m_interconnect->get_num_idle_ticks());
+      }
+      for (auto controller : m_controllers) {
+        if (num_idle_ticks == 0) {
+          break;
+        }
+        num_idle_ticks = std::min(num_idle_ticks, controller->get_num_idle_ticks());
+      }
+      return num_idle_ticks;
+    };
+
+    void skip_idle_ticks(Clk_t n) override {
+      m_clk += n;
+      m_dram->skip_idle_ticks(n);
+      if (m_interconnect) {
+        m_interconnect->skip_idle_ticks(n);
+      }
+      for (auto controller : m_controllers) {
+        controller->skip_idle_ticks(n);
+      }
+    };
+
     float get_tCK() override {
       return m_dram->m_timing_vals("tCK_ps") / 1000.0f;
     }
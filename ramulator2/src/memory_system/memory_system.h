@@ -50,12 +50,37 @@ class IMemorySystem : public TopLevel<IMemorySystem> {
      */
     virtual bool send(Request req) = 0;
 
+    /**
+     * @brief         Sends the request straight to the low-priority buffer of the controller of its channel, bypassing
+     *                the interconnect (e.g., the page copies of a migration). A read calls its callback when it is served.
+     * 
+     * @return   false    Request is rejected (e.g., the buffer is full).
+     */
+    virtual bool copy_send(Request& req) { return false; };
+
+    /**
+     * @brief         Whether copy_send() can accept requests at all, i.e., every controller has a low-priority buffer.
+     * 
+     */
+    virtual bool accepts_copy_requests() { return false; };
+
     /**
      * @brief         Ticks the memory system
      * 
      */
     virtual void tick() = 0;
 
+    /**
+     * @brief    Number of upcoming memory system ticks that cannot change anything observable if no request is sent
+     *           in between. The default of 0 makes the caller tick every cycle.
+     */
+    virtual Clk_t get_num_idle_ticks() { return 0; };
+
+    /**
+     * @brief    Fast-forwards n idle ticks with the same effect (including statistics) as calling tick() n times.
+     */
+    virtual void skip_idle_ticks(Clk_t n) { for (Clk_t i = 0; i < n; i++) tick(); };
+
     /**
      * @brief    Returns 
      * 
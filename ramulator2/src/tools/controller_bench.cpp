@@ -0,0 +1,114 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <argparse/argparse.hpp>
+#include <spdlog/spdlog.h>
+
+#include "base/base.h"
+#include "base/config.h"
+#include "base/topology.h"
+#include "frontend/frontend.h"
+#include "memory_system/memory_system.h"
+
+// Microbenchmark for the memory controller tick path. Drives the memory system of a regular
+// Ramulator2 configuration with a synthetic request stream (through the external-request
+// frontend, so no trace I/O is involved) and reports the wall-clock cost per memory cycle.
+int main(int argc, char* argv[]) {
+  argparse::ArgumentParser program("ramulator2-controller-bench", "2.0");
+  program.add_argument("-f", "--config_file").required()
+    .help("Path to a YAML configuration file, its Frontend section is replaced.");
+  program.add_argument("-p", "--param").metavar("KEY=VALUE").append()
+    .help("Specify parameter to override in the configuration file.");
+  program.add_argument("--cycles").default_value(1000000).scan<'i', int>()
+    .help("Number of memory cycles to simulate.");
+  program.add_argument("--injection_rate").default_value(0.5).scan<'g', double>()
+    .help("Requests offered to the memory system per cycle.");
+  program.add_argument("--write_ratio").default_value(0.3).scan<'g', double>()
+    .help("Fraction of the requests that are writes.");
+  program.add_argument("--locality").default_value(0.5).scan<'g', double>()
+    .help("Probability that a source continues its sequential stream instead of jumping to a random address.");
+  program.add_argument("--num_sources").default_value(8).scan<'i', int>()
+    .help("Number of request sources (cores).");
+  program.add_argument("--addr_bits").default_value(33).scan<'i', int>()
+    .help("Addresses are drawn from [0, 2^addr_bits).");
+  program.add_argument("--seed").default_value(1).scan<'i', int>()
+    .help("Seed of the request stream.");
+
+  try {
+    program.parse_args(argc, argv);
+  }
+  catch (const std::runtime_error& err) {
+    spdlog::error(err.what());
+    std::cerr << program;
+    std::exit(1);
+  }
+
+  std::vector<std::string> params;
+  if (auto arg = program.present<std::vector<std::string>>("-p")) {
+    params = *arg;
+  }
+  YAML::Node config = Ramulator::Config::parse_config_file(program.get<std::string>("-f"), params);
+  config["Frontend"] = YAML::Node();
+  config["Frontend"]["impl"] = "GEM5";
+
+  uint64_t num_cycles = program.get<int>("--cycles");
+  double injection_rate = program.get<double>("--injection_rate");
+  double write_ratio = program.get<double>("--write_ratio");
+  double locality = program.get<double>("--locality");
+  int num_sources = program.get<int>("--num_sources");
+  Ramulator::Addr_t max_addr = (Ramulator::Addr_t(1) << program.get<int>("--addr_bits")) - 1;
+
+  Ramulator::numa_topology.init(config["Topology"]);
+  auto frontend = Ramulator::Factory::create_frontend(config);
+  auto memory_system = Ramulator::Factory::create_memory_system(config);
+  frontend->connect_memory_system(memory_system);
+  memory_system->connect_frontend(frontend);
+
+  std::mt19937_64 rng(program.get<int>("--seed"));
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::vector<Ramulator::Addr_t> streams(num_sources);
+  for (auto& addr : streams) {
+    addr = rng() & max_addr & ~Ramulator::Addr_t(63);
+  }
+
+  uint64_t num_sent = 0, num_rejected = 0, num_reads_served = 0;
+  auto callback = [&num_reads_served](Ramulator::Request&) { num_reads_served++; };
+
+  // Pending request that was rejected and is retried in the next cycle
+  bool has_pending = false;
+  int pending_type = 0, pending_source = 0;
+  Ramulator::Addr_t pending_addr = 0;
+  double credit = 0.0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint64_t clk = 0; clk < num_cycles; clk++) {
+    credit += injection_rate;
+    while (credit >= 1.0 || has_pending) {
+      if (!has_pending) {
+        pending_source = rng() % num_sources;
+        auto& addr = streams[pending_source];
+        addr = (uniform(rng) < locality) ? ((addr + 64) & max_addr) : (rng() & max_addr & ~Ramulator::Addr_t(63));
+        pending_addr = addr;
+        pending_type = (uniform(rng) < write_ratio) ? Ramulator::Request::Type::Write : Ramulator::Request::Type::Read;
+        credit -= 1.0;
+      }
+      has_pending = !frontend->receive_external_requests(pending_type, pending_addr, pending_source, callback);
+      if (has_pending) {
+        num_rejected++;
+        break;
+      }
+      num_sent++;
+    }
+    memory_system->tick();
+  }
+  auto end = std::chrono::steady_clock::now();
+  double seconds = std::chrono::duration<double>(end - start).count();
+
+  spdlog::info("Simulated {} memory cycles in {:.3f} s ({:.1f} ns/cycle, {:.2f} Mcycles/s).",
+               num_cycles, seconds, seconds * 1e9 / num_cycles, num_cycles / seconds / 1e6);
+  spdlog::info("Sent {} requests ({} rejections), served {} reads.", num_sent, num_rejected, num_reads_served);
+  return 0;
+}
@@ -0,0 +1,120 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+
+#include <argparse/argparse.hpp>
+#include <spdlog/spdlog.h>
+
+#include "frontend/impl/memory_trace/binary_trace.h"
+#include "frontend/impl/processor/simpleO3/binary_inst_trace.h"
+
+// Converts a text SimpleO3 trace ("<num_non_memory_insts> <load_addr> [writeback_addr]" per line)
+// into the chunked binary format that SimpleO3 streams.
+static void convert_simpleO3_trace(std::ifstream& input, const std::string& input_path, const std::string& output_path, int chunk_insts) {
+  Ramulator::BinaryInstTraceWriter writer(chunk_insts);
+  if (!writer.open(output_path)) {
+    spdlog::error("Output {} cannot be created!", output_path);
+    std::exit(1);
+  }
+
+  std::string line;
+  size_t line_num = 0;
+  Ramulator::SimpleO3Inst inst;
+  while (std::getline(input, line)) {
+    line_num++;
+    if (line.empty() || line == "\r") {
+      continue;
+    }
+    if (!Ramulator::parse_inst_trace_line(line, inst)) {
+      spdlog::error("Line {}: invalid trace record -> '{}'", line_num, line);
+      std::exit(1);
+    }
+    writer.write(inst);
+  }
+  writer.close();
+
+  spdlog::info("Converted {} instructions from {} into {}.", writer.num_insts(), input_path, output_path);
+}
+
+// Converts a text CustomTrace2 trace into the binary format consumed by the CustomTrace2Binary frontend.
+static void convert_custom2_trace(std::ifstream& input, const std::string& input_path, const std::string& output_path) {
+  Ramulator::BinaryTraceWriter writer;
+  if (!writer.open(output_path)) {
+    spdlog::error("Output {} cannot be created!", output_path);
+    std::exit(1);
+  }
+
+  std::string line;
+  size_t line_num = 0;
+  Ramulator::BinaryTraceRecord record;
+  while (std::getline(input, line)) {
+    line_num++;
+    if (line.empty()) {
+      continue;
+    }
+    if (!Ramulator::parse_text_trace_line(line, record)) {
+      spdlog::error("Line {}: invalid trace record -> '{}'", line_num, line);
+      std::exit(1);
+    }
+    writer.write(record);
+  }
+  writer.close();
+
+  spdlog::info("Converted {} records from {} into {}.", writer.num_records(), input_path, output_path);
+}
+
+// Converts a text CustomTrace2 trace ("<clk> <R|W> <addr> <source_id>" per line) into the
+// binary format consumed by the CustomTrace2Binary frontend, or a SimpleO3 trace with
+// --format simpleO3. The input is streamed, so memory usage does not depend on the trace length.
+int main(int argc, char* argv[]) {
+  argparse::ArgumentParser program("ramulator2-trace-converter", "2.0");
+  program.add_argument("input").help("Path to the text trace.");
+  program.add_argument("output").help("Path to the binary trace to be written.");
+  program.add_argument("--format").metavar("custom2|simpleO3").default_value(std::string("custom2"))
+    .help("Format of the input: CustomTrace2 or SimpleO3 instruction trace.");
+  program.add_argument("--chunk_insts").metavar("N").default_value(1 << 16).scan<'i', int>()
+    .help("Instructions per chunk of a binary SimpleO3 trace (the unit SimpleO3 decodes ahead).");
+
+  try {
+    program.parse_args(argc, argv);
+  }
+  catch (const std::runtime_error& err) {
+    spdlog::error(err.what());
+    std::cerr << program;
+    std::exit(1);
+  }
+
+  std::string input_path = program.get<std::string>("input");
+  std::string output_path = program.get<std::string>("output");
+
+  std::string format = program.get<std::string>("--format");
+  if (format != "custom2" && format != "simpleO3") {
+    spdlog::error("Unknown trace format {}!", format);
+    std::exit(1);
+  }
+
+  std::ifstream input(input_path);
+  if (!input.is_open()) {
+    spdlog::error("Trace {} cannot be opened!", input_path);
+    std::exit(1);
+  }
+
+  // The writers throw if the output cannot be written (e.g., the disk is full)
+  try {
+    if (format == "simpleO3") {
+      int chunk_insts = program.get<int>("--chunk_insts");
+      if (chunk_insts <= 0) {
+        spdlog::error("--chunk_insts must be positive!");
+        std::exit(1);
+      }
+      convert_simpleO3_trace(input, input_path, output_path, chunk_insts);
+    } else {
+      convert_custom2_trace(input, input_path, output_path);
+    }
+  }
+  catch (const std::runtime_error& err) {
+    spdlog::error(err.what());
+    std::exit(1);
+  }
+  return 0;
+}
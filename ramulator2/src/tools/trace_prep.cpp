@@ -0,0 +1,488 @@
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <argparse/argparse.hpp>
+#include <spdlog/spdlog.h>
+
+#include "frontend/impl/memory_trace/binary_trace.h"
+
+// Prepares a raw Sniper DRAM trace ("<ns> <R|W> <addr> <core>" per line, in emission order) for Ramulator2:
+//   1. The input is streamed in chunks bounded by --memory_MB. Each chunk is stable-sorted by timestamp
+//      on a worker thread and spilled to a binary run file.
+//   2. The runs are k-way merged (ties are broken by run order, so the overall sort is stable). To stay
+//      within --max_open_files, groups of runs are first merged into longer runs until few enough are left.
+//   3. A final merge routes every record to the per-core output of its source id, in text (CustomTrace2)
+//      or binary (CustomTrace2Binary) format. With more cores than the open file budget allows, the runs
+//      are read once per group of cores. Optionally, the merged stream is also written as a single trace.
+
+namespace fs = std::filesystem;
+using Ramulator::BinaryTraceRecord;
+
+namespace {
+
+/**
+ * @brief    Output sink for one trace file, either text or binary.
+ *
+ */
+class TraceSink {
+  private:
+    bool m_is_binary = false;
+    std::string m_path;
+    Ramulator::BinaryTraceWriter m_binary;
+    FILE* m_text = nullptr;
+    std::vector<char> m_text_buffer;
+
+  public:
+    TraceSink(const std::string& path, bool is_binary) : m_is_binary(is_binary), m_path(path) {
+      if (m_is_binary) {
+        if (!m_binary.open(path)) {
+          throw std::runtime_error(fmt::format("Output {} cannot be created!", path));
+        }
+      } else {
+        m_text = std::fopen(path.c_str(), "w");
+        if (m_text == nullptr) {
+          throw std::runtime_error(fmt::format("Output {} cannot be created!", path));
+        }
+        m_text_buffer.resize(1 << 20);
+        std::setvbuf(m_text, m_text_buffer.data(), _IOFBF, m_text_buffer.size());
+      }
+    };
+
+    ~TraceSink() {
+      if (m_text != nullptr) {
+        std::fclose(m_text);
+      }
+    };
+
+    void close() {
+      if (m_is_binary) {
+        m_binary.close();
+      } else {
+        bool ok = std::fclose(m_text) == 0;
+        m_text = nullptr;
+        if (!ok) {
+          throw std::runtime_error(fmt::format("Cannot write to output {}!", m_path));
+        }
+      }
+    };
+
+    void write(const BinaryTraceRecord& record) {
+      if (m_is_binary) {
+        m_binary.write(record);
+      } else {
+        char line[96];
+        auto end = fmt::format_to(line, "{} {} {} {}\n", record.clk, record.type_id ? 'W' : 'R', record.addr, record.source_id);
+        std::fwrite(line, 1, end - line, m_text);
+      }
+    };
+};
+
+/**
+ * @brief    Buffered sequential reader over one sorted run file.
+ *
+ */
+class RunReader {
+  private:
+    FILE* m_file = nullptr;
+    std::vector<BinaryTraceRecord> m_buffer;
+    size_t m_pos = 0;
+    size_t m_size = 0;
+
+  public:
+    RunReader(const fs::path& path, size_t buffer_records) : m_buffer(buffer_records) {
+      m_file = std::fopen(path.c_str(), "rb");
+      if (m_file == nullptr) {
+        throw std::runtime_error(fmt::format("Run {} cannot be opened!", path.string()));
+      }
+    };
+
+    ~RunReader() { std::fclose(m_file); };
+
+    bool next(BinaryTraceRecord& record) {
+      if (m_pos == m_size) {
+        m_size = std::fread(m_buffer.data(), sizeof(BinaryTraceRecord), m_buffer.size(), m_file);
+        m_pos = 0;
+        if (m_size == 0) {
+          return false;
+        }
+      }
+      record = m_buffer[m_pos++];
+      return true;
+    };
+};
+
+/**
+ * @brief    Buffered sequential writer of one run file produced by an intermediate merge.
+ *
+ */
+class RunWriter {
+  private:
+    fs::path m_path;
+    FILE* m_file = nullptr;
+    std::vector<char> m_buffer;
+
+  public:
+    explicit RunWriter(const fs::path& path) : m_path(path), m_buffer(1 << 20) {
+      m_file = std::fopen(path.c_str(), "wb");
+      if (m_file == nullptr) {
+        throw std::runtime_error(fmt::format("Cannot write run {}!", path.string()));
+      }
+      std::setvbuf(m_file, m_buffer.data(), _IOFBF, m_buffer.size());
+    };
+
+    ~RunWriter() {
+      if (m_file != nullptr) {
+        std::fclose(m_file);
+      }
+    };
+
+    void write(const BinaryTraceRecord& record) {
+      if (std::fwrite(&record, sizeof(record), 1, m_file) != 1) {
+        throw std::runtime_error(fmt::format("Cannot write run {}!", m_path.string()));
+      }
+    };
+
+    void close() {
+      bool ok = std::fclose(m_file) == 0;
+      m_file = nullptr;
+      if (!ok) {
+        throw std::runtime_error(fmt::format("Cannot write run {}!", m_path.string()));
+      }
+    };
+};
+
+/**
+ * @brief    K-way merge of sorted run files, calling emit on every record in order.
+ *
+ * @details
+ * Ties are broken by the position of the run in runs, so merging runs in input order keeps the sort stable.
+ * All runs are open at once, with buffer_bytes of read buffers shared among them.
+ */
+template <typename Emit_t>
+void merge_runs(const std::vector<fs::path>& runs, size_t buffer_bytes, Emit_t&& emit) {
+  size_t reader_records = std::max<size_t>(buffer_bytes / sizeof(BinaryTraceRecord) / std::max<size_t>(runs.size(), 1), 1024);
+  std::vector<std::unique_ptr<RunReader>> readers;
+  for (const auto& run : runs) {
+    readers.push_back(std::make_unique<RunReader>(run, reader_records));
+  }
+
+  // (clk, run id) as the heap key makes the merge stable with respect to the input order
+  using HeapEntry_t = std::pair<BinaryTraceRecord, size_t>;
+  auto heap_cmp = [](const HeapEntry_t& a, const HeapEntry_t& b) {
+    if (a.first.clk != b.first.clk) {
+      return a.first.clk > b.first.clk;
+    }
+    return a.second > b.second;
+  };
+  std::priority_queue<HeapEntry_t, std::vector<HeapEntry_t>, decltype(heap_cmp)> heap(heap_cmp);
+  BinaryTraceRecord record;
+  for (size_t i = 0; i < readers.size(); i++) {
+    if (readers[i]->next(record)) {
+      heap.emplace(record, i);
+    }
+  }
+
+  while (!heap.empty()) {
+    auto [top, run_id] = heap.top();
+    heap.pop();
+    emit(top);
+    if (readers[run_id]->next(record)) {
+      heap.emplace(record, run_id);
+    }
+  }
+}
+
+/**
+ * @brief    Sorts chunks on a fixed number of worker threads and spills them as run files.
+ *
+ * @details
+ * submit() blocks while all workers are busy, so at most num_threads chunks plus the one being parsed are alive at once.
+ * If the sorter is destroyed without finish() (e.g., while an exception unwinds), pending chunks are dropped and the workers are joined.
+ */
+class RunSorter {
+  private:
+    fs::path m_tmp_dir;
+    std::vector<std::thread> m_workers;
+    std::queue<std::pair<size_t, std::vector<BinaryTraceRecord>>> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_job_cv;
+    std::condition_variable m_slot_cv;
+    size_t m_max_pending = 0;
+    size_t m_num_runs = 0;
+    bool m_done = false;
+    std::exception_ptr m_error;
+
+  public:
+    RunSorter(const fs::path& tmp_dir, int num_threads) : m_tmp_dir(tmp_dir), m_max_pending(num_threads) {
+      for (int i = 0; i < num_threads; i++) {
+        m_workers.emplace_back([this] { work(); });
+      }
+    };
+
+    ~RunSorter() {
+      {
+        std::lock_guard lock(m_mutex);
+        m_done = true;
+        m_jobs = {};
+      }
+      join_workers();
+    };
+
+    fs::path run_path(size_t run_id) const { return m_tmp_dir / fmt::format("run_{}.bin", run_id); };
+
+    void submit(std::vector<BinaryTraceRecord>&& chunk) {
+      std::unique_lock lock(m_mutex);
+      m_slot_cv.wait(lock, [this] { return m_jobs.size() < m_max_pending; });
+      m_jobs.emplace(m_num_runs++, std::move(chunk));
+      m_job_cv.notify_one();
+    };
+
+    size_t finish() {
+      {
+        std::lock_guard lock(m_mutex);
+        m_done = true;
+      }
+      join_workers();
+      if (m_error) {
+        std::rethrow_exception(m_error);
+      }
+      return m_num_runs;
+    };
+
+  private:
+    void join_workers() {
+      m_job_cv.notify_all();
+      for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+          worker.join();
+        }
+      }
+    };
+
+    void work() {
+      while (true) {
+        std::pair<size_t, std::vector<BinaryTraceRecord>> job;
+        {
+          std::unique_lock lock(m_mutex);
+          m_job_cv.wait(lock, [this] { return m_done || !m_jobs.empty(); });
+          if (m_jobs.empty()) {
+            return;
+          }
+          job = std::move(m_jobs.front());
+          m_jobs.pop();
+        }
+        m_slot_cv.notify_one();
+
+        auto& [run_id, chunk] = job;
+        std::stable_sort(chunk.begin(), chunk.end(), [](const BinaryTraceRecord& a, const BinaryTraceRecord& b) {
+          return a.clk < b.clk;
+        });
+
+        FILE* run = std::fopen(run_path(run_id).c_str(), "wb");
+        if (run == nullptr || std::fwrite(chunk.data(), sizeof(BinaryTraceRecord), chunk.size(), run) != chunk.size()) {
+          std::lock_guard lock(m_mutex);
+          m_error = std::make_exception_ptr(std::runtime_error(fmt::format("Cannot write run {}!", run_path(run_id).string())));
+        }
+        if (run != nullptr) {
+          std::fclose(run);
+        }
+      }
+    };
+};
+
+}        // namespace
+
+
+int main(int argc, char* argv[]) {
+  argparse::ArgumentParser program("ramulator2-trace-prep", "2.0");
+  program.add_argument("input").help("Path to the raw DRAM trace (e.g., dram_trace.txt from Sniper).");
+  program.add_argument("-o", "--output_dir").metavar("dir").default_value(std::string("."))
+    .help("Directory for the per-core traces.");
+  program.add_argument("--format").metavar("text|binary").default_value(std::string("text"))
+    .help("Output format: text (CustomTrace2) or binary (CustomTrace2Binary).");
+  program.add_argument("--prefix").metavar("prefix").default_value(std::string("core_"))
+    .help("File name prefix of the per-core traces.");
+  program.add_argument("--merged").metavar("path")
+    .help("Also write the whole sorted trace to this file.");
+  program.add_argument("--memory_MB").metavar("MB").default_value(512).scan<'i', int>()
+    .help("Upper bound of memory used for the in-memory sort chunks.");
+  program.add_argument("--threads").metavar("N").default_value(static_cast<int>(std::max(1u, std::thread::hardware_concurrency()))).scan<'i', int>()
+    .help("Number of sorting threads.");
+  program.add_argument("--max_open_files").metavar("N").default_value(256).scan<'i', int>()
+    .help("Upper bound of the runs and outputs open at once while merging.");
+  program.add_argument("--tmp_dir").metavar("dir")
+    .help("Directory for the temporary sorted runs (defaults to the output directory).");
+
+  try {
+    program.parse_args(argc, argv);
+  }
+  catch (const std::runtime_error& err) {
+    spdlog::error(err.what());
+    std::cerr << program;
+    std::exit(1);
+  }
+
+  std::string input_path = program.get<std::string>("input");
+  fs::path output_dir = program.get<std::string>("--output_dir");
+  std::string format = program.get<std::string>("--format");
+  std::string prefix = program.get<std::string>("--prefix");
+  int memory_MB = program.get<int>("--memory_MB");
+  int num_threads = std::max(1, program.get<int>("--threads"));
+  int max_open_files = program.get<int>("--max_open_files");
+
+  if (format != "text" && format != "binary") {
+    spdlog::error("Unknown output format {}!", format);
+    std::exit(1);
+  }
+  bool is_binary = format == "binary";
+  if (max_open_files < 4) {
+    spdlog::error("--max_open_files must be at least 4!");
+    std::exit(1);
+  }
+
+  std::ifstream input(input_path);
+  if (!input.is_open()) {
+    spdlog::error("Trace {} cannot be opened!", input_path);
+    std::exit(1);
+  }
+
+  fs::create_directories(output_dir);
+  fs::path tmp_dir = output_dir;
+  if (auto arg = program.present<std::string>("--tmp_dir")) {
+    tmp_dir = *arg;
+  }
+  tmp_dir /= fmt::format("ramulator2-trace-prep.{}", ::getpid());
+  fs::create_directories(tmp_dir);
+
+  try {
+    // Phase 1: Stream the input into sorted runs. The budget is shared by the chunk being parsed and the ones being sorted.
+    size_t chunk_records = std::max<size_t>((static_cast<size_t>(memory_MB) << 20) / sizeof(BinaryTraceRecord) / (num_threads + 1), 1024);
+
+    RunSorter sorter(tmp_dir, num_threads);
+    std::vector<BinaryTraceRecord> chunk;
+    chunk.reserve(chunk_records);
+
+    std::string line;
+    size_t line_num = 0;
+    size_t num_records = 0;
+    size_t num_sources = 0;
+    BinaryTraceRecord record;
+    while (std::getline(input, line)) {
+      line_num++;
+      if (line.empty()) {
+        continue;
+      }
+      if (!Ramulator::parse_text_trace_line(line, record)) {
+        throw std::runtime_error(fmt::format("Line {}: invalid trace record -> '{}'", line_num, line));
+      }
+      if (record.source_id < 0) {
+        throw std::runtime_error(fmt::format("Line {}: negative source id {}", line_num, record.source_id));
+      }
+      chunk.push_back(record);
+      num_records++;
+      num_sources = std::max<size_t>(num_sources, record.source_id + 1);
+      if (chunk.size() == chunk_records) {
+        sorter.submit(std::move(chunk));
+        chunk = std::vector<BinaryTraceRecord>();
+        chunk.reserve(chunk_records);
+      }
+    }
+    if (!chunk.empty()) {
+      sorter.submit(std::move(chunk));
+    }
+    std::vector<BinaryTraceRecord>().swap(chunk);
+    size_t num_runs = sorter.finish();
+    spdlog::info("Sorted {} records into {} runs.", num_records, num_runs);
+
+    // Half of the memory budget goes to the read buffers of a merge, and half of the open file budget to its runs
+    size_t buffer_bytes = (static_cast<size_t>(memory_MB) << 20) / 2;
+    size_t fan_in = max_open_files / 2;
+    size_t max_outputs = max_open_files - fan_in - 1;
+
+    // Phase 2: Merge groups of consecutive runs (which keeps the merge stable) until one merge can take all of them
+    std::vector<fs::path> runs;
+    for (size_t i = 0; i < num_runs; i++) {
+      runs.push_back(sorter.run_path(i));
+    }
+    for (size_t pass = 0; runs.size() > fan_in; pass++) {
+      std::vector<fs::path> merged_runs;
+      for (size_t begin = 0; begin < runs.size(); begin += fan_in) {
+        std::vector<fs::path> group(runs.begin() + begin, runs.begin() + std::min(begin + fan_in, runs.size()));
+        if (group.size() == 1) {
+          merged_runs.push_back(group[0]);
+          continue;
+        }
+        fs::path path = tmp_dir / fmt::format("pass_{}_run_{}.bin", pass, merged_runs.size());
+        RunWriter writer(path);
+        merge_runs(group, buffer_bytes, [&](const BinaryTraceRecord& record) { writer.write(record); });
+        writer.close();
+        for (const auto& run : group) {
+          fs::remove(run);
+        }
+        merged_runs.push_back(path);
+      }
+      runs = std::move(merged_runs);
+      spdlog::info("Merge pass {} left {} runs.", pass + 1, runs.size());
+    }
+
+    // Phase 3: Split the merged stream by source id, reading the runs once per group of at most max_outputs cores
+    size_t num_groups = std::max<size_t>((num_sources + max_outputs - 1) / max_outputs, 1);
+    const char* extension = is_binary ? "bin" : "txt";
+    for (size_t group = 0; group < num_groups; group++) {
+      size_t first_source = group * max_outputs;
+      size_t last_source = std::min(first_source + max_outputs, num_sources);
+
+      std::unique_ptr<TraceSink> merged;
+      if (auto arg = program.present<std::string>("--merged"); arg && group == 0) {
+        merged = std::make_unique<TraceSink>(*arg, is_binary);
+      }
+
+      std::vector<std::unique_ptr<TraceSink>> per_core(last_source - first_source);
+      merge_runs(runs, buffer_bytes, [&](const BinaryTraceRecord& record) {
+        if (merged) {
+          merged->write(record);
+        }
+        size_t source = record.source_id;
+        if (source < first_source || source >= last_source) {
+          return;
+        }
+        auto& sink = per_core[source - first_source];
+        if (!sink) {
+          sink = std::make_unique<TraceSink>((output_dir / fmt::format("{}{}.{}", prefix, source, extension)).string(), is_binary);
+        }
+        sink->write(record);
+      });
+
+      for (auto& sink : per_core) {
+        if (sink) {
+          sink->close();
+        }
+      }
+      if (merged) {
+        merged->close();
+      }
+    }
+
+    fs::remove_all(tmp_dir);
+    spdlog::info("Wrote per-core traces to {}.", output_dir.string());
+  }
+  catch (const std::exception& err) {
+    spdlog::error(err.what());
+    fs::remove_all(tmp_dir);
+    std::exit(1);
+  }
+
+  return 0;
+}
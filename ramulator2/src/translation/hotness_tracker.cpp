@@ -0,0 +1,188 @@
+#include <algorithm>
+
+#include "translation/hotness_tracker.h"
+#include "base/exception.h"
+
+namespace Ramulator {
+
+namespace {
+  uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+}
+
+HotnessTracker::HotnessTracker(int num_cores, int top_k, int sketch_width, int sketch_depth, int sample_period, double decay, uint64_t seed)
+  : m_num_cores(num_cores), m_top_k(top_k), m_decay(decay), m_depth(sketch_depth), m_sample_period(sample_period), m_rng_state(seed) {
+  if (top_k <= 0) {
+    throw ConfigurationError("The hotness tracker needs a positive top-K size (got {})!", top_k);
+  }
+  if (sketch_width <= 0 || (sketch_width & (sketch_width - 1)) != 0) {
+    throw ConfigurationError("The width of the hotness sketch must be a power of two (got {})!", sketch_width);
+  }
+  if (sketch_depth <= 0) {
+    throw ConfigurationError("The hotness sketch needs at least one row (got {})!", sketch_depth);
+  }
+  if (sample_period <= 0) {
+    throw ConfigurationError("The hotness sample period must be positive (got {})!", sample_period);
+  }
+  if (decay < 0 || decay >= 1) {
+    throw ConfigurationError("The hotness decay must be in [0, 1) (got {})!", decay);
+  }
+
+  m_width_mask = sketch_width - 1;
+  m_sketch.resize(size_t(sketch_depth) * sketch_width, 0);
+  for (int row = 0; row < m_depth; row++) {
+    // Odd multipliers, one independent hash per row
+    m_row_seeds.push_back(splitmix64(m_rng_state) | 1);
+  }
+
+  m_slots.reserve(m_top_k);
+  m_core_counts.reserve(size_t(m_top_k) * m_num_cores);
+  m_heap.reserve(m_top_k);
+  m_index.reserve(m_top_k * 2);
+  m_sample_countdown = next_sample_gap();
+}
+
+uint32_t HotnessTracker::next_sample_gap() {
+  if (m_sample_period == 1) {
+    return 1;
+  }
+  // Uniform in [1, 2 * period - 1], so strided access patterns do not alias with the sampling
+  return 1 + splitmix64(m_rng_state) % (2 * m_sample_period - 1);
+}
+
+uint32_t& HotnessTracker::get_counter(int row, Addr_t vpn) {
+  uint64_t hash = (uint64_t)vpn * m_row_seeds[row];
+  return m_sketch[row * (m_width_mask + 1) + ((hash ^ (hash >> 32)) & m_width_mask)];
+}
+
+uint32_t HotnessTracker::update_sketch(Addr_t vpn, uint32_t inc) {
+  uint32_t estimate = UINT32_MAX;
+  for (int row = 0; row < m_depth; row++) {
+    estimate = std::min(estimate, get_counter(row, vpn));
+  }
+
+  // Conservative update: only the counters that are below the new estimate grow
+  estimate = estimate > UINT32_MAX - inc ? UINT32_MAX : estimate + inc;
+  for (int row = 0; row < m_depth; row++) {
+    uint32_t& counter = get_counter(row, vpn);
+    counter = std::max(counter, estimate);
+  }
+  return estimate;
+}
+
+void HotnessTracker::record(Addr_t vpn, int core) {
+  uint32_t estimate = update_sketch(vpn, m_sample_period);
+
+  uint32_t slot_id;
+  auto it = m_index.find(vpn);
+  if (it != m_index.end()) {
+    slot_id = it->second;
+    Slot& slot = m_slots[slot_id];
+    slot.count = std::max(slot.count, estimate);
+    sift_down(slot.heap_pos);
+  } else if ((int)m_slots.size() < m_top_k) {
+    slot_id = m_slots.size();
+    m_slots.push_back({vpn, estimate, (uint32_t)m_heap.size()});
+    m_core_counts.resize(m_core_counts.size() + m_num_cores, 0);
+    m_heap.push_back(slot_id);
+    sift_up(m_slots[slot_id].heap_pos);
+    m_index[vpn] = slot_id;
+  } else {
+    // Replace the coldest tracked page if the new one is hotter
+    slot_id = m_heap[0];
+    Slot& slot = m_slots[slot_id];
+    if (estimate <= slot.count) {
+      return;
+    }
+    m_index.erase(slot.vpn);
+    slot.vpn = vpn;
+    slot.count = estimate;
+    std::fill_n(&m_core_counts[slot_id * m_num_cores], m_num_cores, 0);
+    sift_down(0);
+    m_index[vpn] = slot_id;
+  }
+
+  m_core_counts[slot_id * m_num_cores + core] += m_sample_period;
+}
+
+const std::vector<uint32_t>& HotnessTracker::get_hottest() {
+  m_hottest.resize(m_slots.size());
+  for (uint32_t i = 0; i < m_hottest.size(); i++) {
+    m_hottest[i] = i;
+  }
+  std::sort(m_hottest.begin(), m_hottest.end(), [this](uint32_t a, uint32_t b) { return m_slots[a].count > m_slots[b].count; });
+  return m_hottest;
+}
+
+void HotnessTracker::end_window() {
+  for (uint32_t& counter : m_sketch) {
+    counter = uint32_t(counter * m_decay);
+  }
+  for (uint32_t& count : m_core_counts) {
+    count = uint32_t(count * m_decay);
+  }
+
+  // Keep the slots whose count survives the decay, and rebuild the heap and the index over them
+  size_t num_slots = 0;
+  for (size_t i = 0; i < m_slots.size(); i++) {
+    uint32_t count = uint32_t(m_slots[i].count * m_decay);
+    if (count == 0) {
+      continue;
+    }
+    m_slots[num_slots] = {m_slots[i].vpn, count, 0};
+    std::copy_n(&m_core_counts[i * m_num_cores], m_num_cores, &m_core_counts[num_slots * m_num_cores]);
+    num_slots++;
+  }
+  m_slots.resize(num_slots);
+  m_core_counts.resize(num_slots * m_num_cores);
+
+  m_index.clear();
+  m_heap.clear();
+  for (uint32_t i = 0; i < num_slots; i++) {
+    m_index[m_slots[i].vpn] = i;
+    m_slots[i].heap_pos = i;
+    m_heap.push_back(i);
+  }
+  for (uint32_t pos = num_slots / 2; pos-- > 0;) {
+    sift_down(pos);
+  }
+}
+
+void HotnessTracker::sift_up(uint32_t pos) {
+  while (pos > 0) {
+    uint32_t parent = (pos - 1) / 2;
+    if (m_slots[m_heap[parent]].count <= m_slots[m_heap[pos]].count) {
+      return;
+    }
+    swap_heap(pos, parent);
+    pos = parent;
+  }
+}
+
+void HotnessTracker::sift_down(uint32_t pos) {
+  while (true) {
+    uint32_t smallest = pos;
+    for (uint32_t child = 2 * pos + 1; child <= 2 * pos + 2 && child < m_heap.size(); child++) {
+      if (m_slots[m_heap[child]].count < m_slots[m_heap[smallest]].count) {
+        smallest = child;
+      }
+    }
+    if (smallest == pos) {
+      return;
+    }
+    swap_heap(pos, smallest);
+    pos = smallest;
+  }
+}
+
+void HotnessTracker::swap_heap(uint32_t a, uint32_t b) {
+  std::swap(m_heap[a], m_heap[b]);
+  m_slots[m_heap[a]].heap_pos = a;
+  m_slots[m_heap[b]].heap_pos = b;
+}
+
+}        // namespace Ramulator
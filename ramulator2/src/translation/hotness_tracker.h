@@ -0,0 +1,103 @@
+#ifndef     RAMULATOR_TRANSLATION_HOTNESS_TRACKER_H
+#define     RAMULATOR_TRANSLATION_HOTNESS_TRACKER_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "base/type.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Approximate, decaying access counts of the hottest pages, for migration decisions.
+ *
+ * @details
+ * A sample of the accesses (one in sample_period on average, at random gaps) is counted in a count-min sketch of
+ * depth rows x width counters with conservative update. A sampled access adds sample_period, so the counts stay in
+ * accesses. The top_k pages with the highest sketch estimates are kept in a min-heap. Each of these pages also keeps
+ * per-core counts of its sampled accesses since it entered the top-K. A page that is not in the top-K replaces the
+ * coldest one once its estimate exceeds that page's count.
+ *
+ * Ending a window multiplies all counts by decay instead of clearing them (decay 0 keeps only the current window),
+ * and drops top-K pages whose count reaches zero. Both an access and a window end cost the same for any footprint:
+ * O(depth + log top_k) and O(depth * width + top_k).
+ */
+class HotnessTracker {
+  public:
+    static constexpr uint32_t npos = -1;
+
+  private:
+    struct Slot {
+      Addr_t vpn = -1;
+      uint32_t count = 0;
+      uint32_t heap_pos = 0;
+    };
+
+    int m_num_cores = 0;
+    int m_top_k = 0;
+    double m_decay = 0;
+
+    std::vector<uint32_t> m_sketch;       // Per row x column
+    std::vector<uint64_t> m_row_seeds;
+    size_t m_width_mask = 0;
+    int m_depth = 0;
+
+    uint32_t m_sample_period = 1;
+    uint32_t m_sample_countdown = 1;
+    uint64_t m_rng_state = 0;
+
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_core_counts;  // Per slot x core
+    std::vector<uint32_t> m_heap;         // Slot ids, the slot with the smallest count on top
+    std::unordered_map<Addr_t, uint32_t> m_index;
+
+    std::vector<uint32_t> m_hottest;
+
+  public:
+    HotnessTracker() = default;
+    HotnessTracker(int num_cores, int top_k, int sketch_width, int sketch_depth, int sample_period, double decay, uint64_t seed);
+
+    /**
+     * @brief    Counts an access by core to the page, if it is sampled. Accesses by requesters that are not cores are not counted.
+     */
+    void access(Addr_t vpn, int core) {
+      if (core < 0 || core >= m_num_cores) {
+        return;
+      }
+      if (--m_sample_countdown != 0) {
+        return;
+      }
+      m_sample_countdown = next_sample_gap();
+      record(vpn, core);
+    };
+
+    /**
+     * @brief    Slot ids of the tracked pages, hottest first. Valid until the next access or end_window().
+     */
+    const std::vector<uint32_t>& get_hottest();
+
+    Addr_t get_vpn(uint32_t slot) const { return m_slots[slot].vpn; };
+    uint32_t get_count(uint32_t slot) const { return m_slots[slot].count; };
+    const uint32_t* get_core_counts(uint32_t slot) const { return &m_core_counts[slot * m_num_cores]; };
+    int get_num_cores() const { return m_num_cores; };
+
+    /**
+     * @brief    Decays all counts for a new window.
+     */
+    void end_window();
+
+  private:
+    void record(Addr_t vpn, int core);
+    uint32_t& get_counter(int row, Addr_t vpn);
+    uint32_t update_sketch(Addr_t vpn, uint32_t inc);
+    uint32_t next_sample_gap();
+
+    void sift_up(uint32_t pos);
+    void sift_down(uint32_t pos);
+    void swap_heap(uint32_t a, uint32_t b);
+};
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_TRANSLATION_HOTNESS_TRACKER_H
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <deque>
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
@@ -6,7 +7,12 @@
 #include "dram/dram.h"
 #include "base/base.h"
 #include "base/utils.h"
+#include "base/topology.h"
 #include "translation/translation.h"
+#include "translation/page_allocator.h"
+#include "translation/page_table.h"
+#include "translation/page_placement.h"
+#include "translation/hotness_tracker.h"
 #include "frontend/frontend.h"
 #include "memory_system/memory_system.h"
 #include <ctime>
@@ -19,8 +25,20 @@ namespace Ramulator
         RAMULATOR_REGISTER_IMPLEMENTATION(ITranslation, Dynamic_migration, "Dynamic_migration", "Randomly allocate physical pages to virtual pages.");
 
         IFrontEnd *m_frontend;
+        IMemorySystem *m_memory_system = nullptr;
 
     protected:
+        // A page copy of a migration: the lines are read from the old page and written to the new one, each read
+        // that is served sends the write of its line and the next read
+        struct PageCopy
+        {
+            Addr_t src_ppn = -1;
+            Addr_t dst_ppn = -1;
+            int next_line = 0;  // Next line to read
+            int lines_done = 0; // Lines that are read and whose write is sent
+            Clk_t first_depart = -1;
+        };
+
         std::mt19937_64 m_allocator_rng;
 
         Addr_t m_max_paddr; // Maximum physical address
@@ -35,27 +53,39 @@ namespace Ramulator
 
         size_t m_cost = 0;
 
-        size_t pages_per_channel;
-
-        // Free physical page tracking (divided into 8 partitions for 8 channels)
-        std::vector<std::vector<bool>> m_free_physical_pages2d;
-        std::vector<size_t> m_num_free_physical_pages_per_part;
+        int m_num_channels; // Number of channels (partitions) in the NUMA topology
 
-        std::unordered_map<Addr_t, Addr_t> global_page_table; // VPN → PPN
+        // Free physical page tracking (one partition per channel)
+        PageAllocator m_page_allocator;
 
-        std::unordered_map<Addr_t, Addr_t> reverse_page_table; // PPN → VPN (for fast eviction)
+        PageTable m_page_table; // VPN → PPN and channel, with the core-wise page accesses of the current window
 
-        std::unordered_map<size_t, std::unordered_map<size_t, size_t>> page_access_counts_per_core; // Core-wise page accesses
-
-        // std::unordered_map<size_t, size_t> page_to_channel_mapping;                                 // VPN → Channel
+        // Sampled, decaying counts of the hottest pages, used instead of the exact counts of the page table if enabled
+        bool m_use_hotness_tracker = false;
+        HotnessTracker m_hotness;
+        size_t s_migration_candidates = 0; // Pages considered for migration over all windows
 
         std::unordered_set<Addr_t> m_reserved_pages; // Reserved pages
 
-        std::unordered_map<Addr_t, int> last_migration_window; // VPN → last migrated window
         int COOLDOWN_WINDOWS;   
         
         double bandwidth;  // Cooldown period in windows
 
+        bool m_migration_traffic = false; // Copy the pages through the memory system instead of the analytic cost
+        int m_lines_per_page;
+        int m_linesize;
+        int m_copy_inflight;             // Reads of a page copy in flight
+
+        std::vector<PageCopy> m_copies;
+        std::vector<uint32_t> m_free_copies;
+        std::deque<Request> m_copy_retry; // Copy requests rejected by the memory system, resent in tick()
+
+        size_t s_copy_reads = 0;
+        size_t s_copy_writes = 0;
+        size_t s_pages_copied = 0;
+        size_t s_copy_cycles = 0; // Memory cycles from the first to the last line read of each page copy
+        float s_avg_copy_cycles = 0;
+
     public:
         void init() override
         {
@@ -80,28 +110,71 @@ namespace Ramulator
             m_num_pages = m_max_paddr / m_pagesize;
 
             // Initialize free physical page tracking
-            pages_per_channel = m_num_pages / 8;
-            m_free_physical_pages2d = std::vector<std::vector<bool>>(8, std::vector<bool>(pages_per_channel, true));
-            m_num_free_physical_pages_per_part = std::vector<size_t>(8, pages_per_channel);
+            m_num_channels = numa_topology.get_num_channels();
+            m_page_allocator = PageAllocator(m_num_pages, m_num_channels);
+
+            int tlb_size = param<int>("tlb_size").desc("Number of entries of the software TLB in front of the page table (a power of two).").default_val(64);
+            m_page_table = PageTable(numa_topology.get_num_cores(), tlb_size);
+
+            int hotness_top_k = param<int>("hotness_top_k").desc("Number of hottest pages tracked by the sampled hotness tracker, which are the only migration candidates. 0 counts every access of every page exactly per window.").default_val(0);
+            if (hotness_top_k > 0)
+            {
+                int sketch_width = param<int>("hotness_sketch_width").desc("Counters per row of the count-min sketch of the hotness tracker (a power of two).").default_val(4096);
+                int sketch_depth = param<int>("hotness_sketch_depth").desc("Rows of the count-min sketch of the hotness tracker.").default_val(4);
+                int sample_period = param<int>("hotness_sample_period").desc("The hotness tracker counts one in this many accesses on average.").default_val(1);
+                double decay = param<double>("hotness_decay").desc("Factor the hotness counts are multiplied by at the end of each window.").default_val(0.5);
+                m_hotness = HotnessTracker(numa_topology.get_num_cores(), hotness_top_k, sketch_width, sketch_depth, sample_period, decay, seed);
+                m_use_hotness_tracker = true;
+            }
 
             m_logger = Logging::create_logger("Dynamic_migration");
 
             m_cost = calculate_migration_cost(m_pagesize,bandwidth); // Example memory bandwidth
 
+            m_migration_traffic = param<bool>("migration_traffic").desc("Copy migrated pages with read/write requests to the low-priority copy buffers of the controllers, and weigh the measured copy time against the gain. Needs a memory system that accepts copy requests (e.g., GenericDRAM, or CustomDRAM with num_threads: 1).").default_val(false);
+            m_linesize = param<int>("linesize").desc("Bytes per request of a page copy.").default_val(64);
+            m_lines_per_page = m_pagesize / m_linesize;
+            m_copy_inflight = param<int>("copy_inflight").desc("Reads of a page copy that are in flight at once.").default_val(8);
+
+            register_stat(s_copy_reads).name("migration_copy_reads");
+            register_stat(s_copy_writes).name("migration_copy_writes");
+            register_stat(s_pages_copied).name("migration_pages_copied");
+            register_stat(s_avg_copy_cycles).name("migration_avg_copy_cycles");
+            register_stat(s_migration_candidates).name("migration_candidates");
+
             // std::cout << "Total Physical Pages: " << m_num_pages << std::endl;
             // std::cout << "Pages Per Partition: " << pages_per_channel << std::endl;
         };
 
+        void setup(IFrontEnd *frontend, IMemorySystem *memory_system) override
+        {
+            m_memory_system = memory_system;
+            if (m_migration_traffic && !m_memory_system->accepts_copy_requests())
+                throw ConfigurationError("Dynamic_migration: migration_traffic needs a memory system whose controllers accept copy requests (e.g., GenericDRAM, or CustomDRAM with num_threads: 1)!");
+        };
+
+        void tick() override
+        {
+            while (!m_copy_retry.empty() && send_copy_request(m_copy_retry.front()))
+                m_copy_retry.pop_front();
+        };
+
+        bool is_idle() override
+        {
+            return m_copy_retry.empty();
+        };
+
+        void finalize() override
+        {
+            s_avg_copy_cycles = s_pages_copied == 0 ? 0 : (float)s_copy_cycles / s_pages_copied;
+        };
+
         bool translate(Request &req) override
         {
             req.v_addr = req.addr;                 // Store the virtual address
             Addr_t vpn = req.addr >> m_offsetbits; // Extract VPN from address
             req.vpage = vpn;                       // Save VPN
 
-            // Update access count for this VPN by the requesting core
-            // std::cout << " core id " << req.source_id << " VPN " << vpn << std::endl;
-            page_access_counts_per_core[vpn][req.source_id]++;
-
             migration_counter++;
             if (migration_counter == STABILITY_WINDOW)
             {
@@ -109,49 +182,26 @@ namespace Ramulator
                 migration_counter = 0;
             }
 
-            // If the VPN is already translated, return the existing mapping
-            if (global_page_table.find(vpn) != global_page_table.end())
+            // If the VPN is not translated yet, assign a new physical page
+            uint32_t id = m_page_table.find(vpn);
+            if (id == PageTable::npos)
             {
-                Addr_t p_addr = (global_page_table[vpn] << m_offsetbits) | (req.addr & ((1 << m_offsetbits) - 1));
-                req.addr = p_addr;
-                DEBUG_LOG(DTRANSLATE, m_logger, "Translated Addr {}, VPN {} to Addr {}, PPN {}.", req.addr, vpn, p_addr, global_page_table[vpn]);
-                return true;
+                int ch = find_best_channel(req.source_id); // Choose best channel (here a simple hash is used)
+                Addr_t ppn = PagePlacement::find_random_free_page(m_page_allocator, m_page_table, m_reserved_pages, ch, m_allocator_rng);
+                id = m_page_table.insert(vpn, ppn, ch);
             }
 
-            // Otherwise, assign a new physical page
-            Addr_t ppn;
-            int ch = find_best_channel(req.source_id); // Choose best channel (here a simple hash is used)
-
-            if (m_num_free_physical_pages_per_part[ch] > 0) // Free pages available in chosen partition
-            {
-                bool flag = true;
-                while (flag)
-                {
-                    // Select a random page in the partition: random offset within partition plus partition start offset
-                    ppn = (m_allocator_rng() % pages_per_channel) + (ch * pages_per_channel);
-                    if (m_free_physical_pages2d[ch][ppn % pages_per_channel])
-                    {
-                        flag = false;
-                        m_free_physical_pages2d[ch][ppn % pages_per_channel] = false;
-                        m_num_free_physical_pages_per_part[ch]--;
-                    }
-                }
-            }
+            // Update access count for this VPN by the requesting core
+            if (m_use_hotness_tracker)
+                m_hotness.access(vpn, req.source_id);
             else
-            {
-                // If no free page exists in the partition, evict a page and replace it
-                ppn = evict_and_replace_page(ch);
-            }
-
-            // Update mappings: VPN to PPN and reverse
-            global_page_table[vpn] = ppn;
-            reverse_page_table[ppn] = vpn;
-            page_to_channel_mapping[vpn] = ch;
+                m_page_table.count(id, req.source_id);
 
             // Compute the translated physical address (preserving offset bits)
-            Addr_t p_addr = (global_page_table[vpn] << m_offsetbits) | (req.addr & ((1 << m_offsetbits) - 1));
-            DEBUG_LOG(DTRANSLATE, m_logger, "Translated Addr {}, VPN {} to Addr {}, PPN {}.", req.addr, vpn, p_addr, global_page_table[vpn]);
-            // m_logger->info("Translated Addr {}, VPN {} to Addr {}, PPN {}, channel: {}", req.addr, vpn, p_addr, global_page_table[vpn], ch);
+            Addr_t ppn = m_page_table.get(id).ppn;
+            Addr_t p_addr = (ppn << m_offsetbits) | (req.addr & ((1 << m_offsetbits) - 1));
+            DEBUG_LOG(DTRANSLATE, m_logger, "Translated Addr {}, VPN {} to Addr {}, PPN {}.", req.addr, vpn, p_addr, ppn);
+            // m_logger->info("Translated Addr {}, VPN {} to Addr {}, PPN {}, channel: {}", req.addr, vpn, p_addr, ppn, m_page_table.get(id).channel);
             req.addr = p_addr;
             return true;
         };
@@ -162,169 +212,207 @@ namespace Ramulator
             // std::cout<<"Migration window: " << window_counter << std::endl;
             // std::cout << "Migrating called..." << std::endl;
             // std::cout << "Window: " << window_counter << std::endl;
-            for (const auto &entry : global_page_table)
-            {
-                size_t vpn = entry.first;
-                Addr_t ppn = entry.second;
-
-                if (!is_hot_page(vpn))
-                    continue;
-
-                if (vpn == 0)
-                    continue;
 
-                size_t most_frequent_core = find_most_frequent_core(vpn);
-                size_t best_channel = find_best_channel(most_frequent_core);
-                size_t current_channel = page_to_channel_mapping[vpn];
-
-                if (best_channel == current_channel)
-                    continue;
-
-                // Cooldown check
-                if (last_migration_window.find(vpn) != last_migration_window.end())
-                {
-                    int last_window = last_migration_window[vpn];
-                    if ((window_counter - last_window) < COOLDOWN_WINDOWS)
-                    {
-                        m_logger->info("VPN {} is cooling down (last migrated in window {}).", vpn, last_window);
-                        continue;
-                    }
-                }
-
-                double gain = estimate_latency_gain(vpn, most_frequent_core);
-                double cost = m_cost;
-                gain /= 1000;
-
-                if (gain > cost)
+            if (m_use_hotness_tracker)
+            {
+                // Only the tracked pages are candidates, hottest first (they may have been evicted since)
+                for (uint32_t slot : m_hotness.get_hottest())
                 {
-                    ppn = find_random_free_page(best_channel);
-                    global_page_table[vpn] = ppn;
-                    page_to_channel_mapping[vpn] = best_channel;
-                    m_logger->info("Migrated VPN {} to a new page in channel {}. in window {}", vpn, best_channel, window_counter);
-                    // m_logger->info("Migrated VPN {} to a new page in channel {}.", vpn, page_to_channel_mapping[vpn]);
-                    last_migration_window[vpn] = window_counter;
-                    migrations++;
+                    uint32_t id = m_page_table.find(m_hotness.get_vpn(slot));
+                    if (id != PageTable::npos)
+                        try_migrate_page(id, m_hotness.get_core_counts(slot));
                 }
-                else
+                m_hotness.end_window();
+            }
+            else
+            {
+                // Only the pages accessed in this window can be hot (evictions during the loop mark their pages npos)
+                const auto &touched = m_page_table.get_touched();
+                for (size_t i = 0; i < touched.size(); i++)
                 {
-                    m_logger->info("Migration not beneficial for VPN {}.", vpn);
-                    std::cout << "Cost: " << cost << ", Gain: " << gain << std::endl;
+                    uint32_t id = touched[i];
+                    if (id != PageTable::npos)
+                        try_migrate_page(id, m_page_table.get_counts(id));
                 }
             }
 
             window_counter++;
 
-            reset_all_page_access_counts();
+            m_page_table.end_window();
         }
 
-        size_t find_most_frequent_core(Addr_t vpn)
+        // Migrate the page next to the core that accessed it most, if it is hot and the latency gain outweighs the cost
+        void try_migrate_page(uint32_t id, const uint32_t *counts)
         {
-            size_t most_frequent_core = 0;
-            size_t max_access_count = 0;
+            s_migration_candidates++;
+
+            auto &entry = m_page_table.get(id);
+            size_t vpn = entry.vpn;
+            Addr_t ppn = entry.ppn;
+
+            if (!PagePlacement::is_hot_page(counts, m_page_table.get_num_cores(), HOT_PAGE_THRESHOLD))
+                return;
+
+            if (vpn == 0)
+                return;
+
+            size_t most_frequent_core = find_most_frequent_core(counts);
+            size_t best_channel = find_best_channel(most_frequent_core);
+            size_t current_channel = entry.channel;
+
+            if (best_channel == current_channel)
+                return;
 
-            if (page_access_counts_per_core.find(vpn) != page_access_counts_per_core.end())
+            // Cooldown check
+            if (entry.last_migration_window >= 0)
             {
-                for (const auto &entry : page_access_counts_per_core[vpn])
+                int last_window = entry.last_migration_window;
+                if ((window_counter - last_window) < COOLDOWN_WINDOWS)
                 {
-                    if (entry.second > max_access_count)
-                    {
-                        max_access_count = entry.second;
-                        most_frequent_core = entry.first;
-                    }
+                    m_logger->info("VPN {} is cooling down (last migrated in window {}).", vpn, last_window);
+                    return;
                 }
             }
-            return most_frequent_core;
-        }
-
-        size_t find_best_channel(size_t core)
-        {
-            size_t best_channel = 0;
-            size_t min_latency = SIZE_MAX;
 
-            for (size_t channel = 0; channel < 8; channel++)
+            double gain = estimate_latency_gain(id, counts, most_frequent_core);
+            double cost = m_cost;
+            if (m_migration_traffic)
+            {
+                // Both in memory cycles, a copy is assumed to take a cycle per line until one is measured
+                cost = s_pages_copied == 0 ? m_lines_per_page : (double)s_copy_cycles / s_pages_copied;
+            }
+            else
+            {
+                gain /= 1000;
+            }
 
+            if (gain > cost)
             {
-                if (core_channel_latency_matrix[core][channel] < min_latency)
-                {
-                    min_latency = core_channel_latency_matrix[core][channel];
-                    best_channel = channel;
-                }
+                Addr_t old_ppn = ppn;
+                ppn = PagePlacement::find_random_free_page(m_page_allocator, m_page_table, m_reserved_pages, best_channel, m_allocator_rng);
+                m_page_table.remap(id, ppn, best_channel);
+                if (m_migration_traffic && m_memory_system)
+                    start_page_copy(old_ppn, ppn);
+                else
+                    m_page_allocator.free(old_ppn);
+                m_logger->info("Migrated VPN {} to a new page in channel {}. in window {}", vpn, best_channel, window_counter);
+                // m_logger->info("Migrated VPN {} to a new page in channel {}.", vpn, entry.channel);
+                entry.last_migration_window = window_counter;
+                migrations++;
+            }
+            else
+            {
+                m_logger->info("Migration not beneficial for VPN {} (cost {}, gain {}).", vpn, cost, gain);
             }
-            return best_channel;
         }
 
-        Addr_t find_random_free_page(int ch)
+        void start_page_copy(Addr_t src_ppn, Addr_t dst_ppn)
         {
-
-            // Check if any free page exists in this partition.
-            if (m_num_free_physical_pages_per_part[ch] == 0)
+            uint32_t copy_id;
+            if (m_free_copies.empty())
             {
-                // Fallback to eviction (this should normally not happen if the caller checks first)
-                return evict_and_replace_page(ch);
+                copy_id = m_copies.size();
+                m_copies.emplace_back();
             }
-
-            Addr_t ppn;
-            while (true)
+            else
             {
-                // Select a random offset within the partition and add the partition's starting offset.
-                ppn = (m_allocator_rng() % pages_per_channel) + (ch * pages_per_channel);
-                // Use modulo to index into the partition vector.
-                if (m_free_physical_pages2d[ch][ppn % pages_per_channel])
-                {
-                    m_free_physical_pages2d[ch][ppn % pages_per_channel] = false;
-                    m_num_free_physical_pages_per_part[ch]--;
-                    return ppn;
-                }
+                copy_id = m_free_copies.back();
+                m_free_copies.pop_back();
             }
+            PageCopy &copy = m_copies[copy_id];
+            copy = PageCopy();
+            copy.src_ppn = src_ppn;
+            copy.dst_ppn = dst_ppn;
+            for (int i = 0; i < m_copy_inflight && copy.next_line < m_lines_per_page; i++)
+                send_copy_read(copy_id);
         }
 
-        Addr_t evict_and_replace_page(int ch)
+        void send_copy_read(uint32_t copy_id)
         {
-            size_t pages_per_channel = m_num_pages / 8;
-            // Randomly select a victim page within the channel partition
-            Addr_t victim_ppn = (m_allocator_rng() % pages_per_channel) + (ch * pages_per_channel);
-
-            // Use the reverse page table for an O(1) lookup of the corresponding VPN
-            Addr_t victim_vpn = reverse_page_table[victim_ppn];
-
-            // Remove the victim's mapping from all tables
-            global_page_table.erase(victim_vpn);
-            reverse_page_table.erase(victim_ppn);
-            page_to_channel_mapping.erase(victim_vpn);
-
-            std::cout << "Evicted VPN: " << victim_vpn << " -> PPN: " << victim_ppn << " from channel " << ch << std::endl;
+            PageCopy &copy = m_copies[copy_id];
+            Addr_t addr = (copy.src_ppn << m_offsetbits) + (Addr_t)copy.next_line * m_linesize;
+            copy.next_line++;
+            Request read_req(addr, Request::Type::Read, -1, [this, copy_id](Request &req) { this->copy_read_done(copy_id, req); });
+            if (!send_copy_request(read_req))
+                m_copy_retry.push_back(read_req);
+        }
 
-            // Mark the victim page as free again
-            m_free_physical_pages2d[ch][victim_ppn % pages_per_channel] = true;
-            m_num_free_physical_pages_per_part[ch]++;
+        void copy_read_done(uint32_t copy_id, Request &req)
+        {
+            PageCopy &copy = m_copies[copy_id];
+            if (copy.first_depart == -1)
+                copy.first_depart = req.depart;
+
+            int line = (req.addr - (copy.src_ppn << m_offsetbits)) / m_linesize;
+            Request write_req((copy.dst_ppn << m_offsetbits) + (Addr_t)line * m_linesize, Request::Type::Write, -1);
+            if (!send_copy_request(write_req))
+                m_copy_retry.push_back(write_req);
+
+            if (copy.next_line < m_lines_per_page)
+                send_copy_read(copy_id);
+
+            if (++copy.lines_done < m_lines_per_page)
+                return;
+
+            // The old page is free unless an eviction has handed it over to another mapping in the meantime
+            if (m_page_table.find_by_ppn(copy.src_ppn) == PageTable::npos)
+                m_page_allocator.free(copy.src_ppn);
+            s_pages_copied++;
+            s_copy_cycles += req.depart - copy.first_depart;
+            m_free_copies.push_back(copy_id);
+        }
 
-            // Allocate and return a new free page from this partition
-            return find_random_free_page(ch);
+        bool send_copy_request(Request &req)
+        {
+            if (!m_memory_system->copy_send(req))
+                return false;
+            if (req.type_id == Request::Type::Read)
+                s_copy_reads++;
+            else
+                s_copy_writes++;
+            return true;
         }
 
-        // Determine if a page is "hot" (i.e., frequently accessed) based on a threshold.
-        bool is_hot_page(size_t vpn)
+        size_t find_most_frequent_core(const uint32_t *counts)
         {
-            size_t total_access_count = 0;
-            for (const auto &[core_id, count] : page_access_counts_per_core[vpn])
+            size_t most_frequent_core = 0;
+            size_t max_access_count = 0;
+
+            if (counts)
             {
-                total_access_count += count;
+                for (int core = 0; core < m_page_table.get_num_cores(); core++)
+                {
+                    if (counts[core] > max_access_count)
+                    {
+                        max_access_count = counts[core];
+                        most_frequent_core = core;
+                    }
+                }
             }
-            return total_access_count >= HOT_PAGE_THRESHOLD;
+            return most_frequent_core;
         }
 
-        double estimate_latency_gain(size_t page_id, size_t current_core)
+        size_t find_best_channel(size_t core)
         {
-            size_t current_channel = page_to_channel_mapping[page_id]; // Track assigned channel
-            size_t best_channel = std::distance(core_channel_latency_matrix[current_core],
-                                                std::min_element(core_channel_latency_matrix[current_core],
-                                                                 core_channel_latency_matrix[current_core] + 8));
+            // Requesters outside the topology have no nearest channel
+            if (!numa_topology.is_core(core))
+                return 0;
+            return numa_topology.get_nearest_channel(core);
+        }
+
+        double estimate_latency_gain(uint32_t id, const uint32_t *counts, size_t current_core)
+        {
+            if (!numa_topology.is_core(current_core) || !counts)
+                return 0;
 
-            double current_latency = core_channel_latency_matrix[current_core][current_channel];
-            double new_latency = core_channel_latency_matrix[current_core][best_channel];
+            size_t current_channel = m_page_table.get(id).channel; // Track assigned channel
+            size_t best_channel = find_best_channel(current_core);
+
+            double current_latency = numa_topology.get_latency(current_core, current_channel);
+            double new_latency = numa_topology.get_latency(current_core, best_channel);
 
             // 📌 Predict future accesses using historical access count
-            size_t recent_accesses = page_access_counts_per_core[page_id][current_core];
+            size_t recent_accesses = counts[current_core];
             size_t predicted_accesses = recent_accesses * FUTURE_ACCESS_FACTOR; // Multiplier for future prediction
 
             double total_gain = (current_latency - new_latency) * 2 * predicted_accesses;
@@ -347,14 +435,11 @@ namespace Ramulator
 
             return cost_in_microseconds;
         }
-        void reset_all_page_access_counts()
-        {
-            page_access_counts_per_core.clear();
-        }
         bool reserve(const std::string &type, Addr_t addr) override
         {
             Addr_t ppn = addr >> m_offsetbits;
             m_reserved_pages.insert(ppn);
+            m_page_allocator.allocate(ppn);
             return true;
         };
 
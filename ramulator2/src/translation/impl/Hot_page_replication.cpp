@@ -0,0 +1,376 @@
+#include <algorithm>
+#include <unordered_set>
+#include <unordered_map>
+#include <vector>
+#include <random>
+#include "base/base.h"
+#include "base/utils.h"
+#include "base/topology.h"
+#include "translation/translation.h"
+#include "translation/page_allocator.h"
+#include "translation/page_table.h"
+#include "translation/page_placement.h"
+#include <cstdint>
+
+namespace Ramulator
+{
+    /**
+     * @brief    Keeps read-only replicas of hot read-shared pages in the channels nearest to their readers.
+     *
+     * @details
+     * Pages are first placed in the channel nearest to the first requester, like Local_to_requester. At the end of
+     * every window, a hot page that was not written in the window and that is read by cores with different nearest
+     * channels gets a replica in each of these channels. Reads go to the copy nearest to the requester, a write goes
+     * to the primary copy and drops all replicas of the page. Replicas of pages that are not accessed for a whole
+     * window are dropped as well, and the total number of replica pages never exceeds replica_budget.
+     */
+    class Hot_page_replication : public ITranslation, public Implementation
+    {
+        RAMULATOR_REGISTER_IMPLEMENTATION(ITranslation, Hot_page_replication, "Hot_page_replication", "Replicate hot read-shared pages into the channels nearest to their readers.");
+
+    protected:
+        struct Replica
+        {
+            int channel;
+            Addr_t ppn;
+        };
+
+        struct ReplicaSet
+        {
+            uint32_t owner = PageTable::npos; // Page table entry of the primary copy, npos if the set is free
+            std::vector<Replica> replicas;
+        };
+
+        std::mt19937_64 m_allocator_rng;
+
+        Addr_t m_max_paddr; // Maximum physical address
+        Addr_t m_pagesize;  // Page size in bytes
+        int m_offsetbits;   // Number of bits for the page offset
+        size_t m_num_pages; // Total number of physical pages
+
+        size_t access_counter = 0;
+        size_t HOT_PAGE_THRESHOLD;
+        size_t STABILITY_WINDOW;
+        size_t SHARER_THRESHOLD;
+        int window_counter = 0;
+
+        size_t m_replica_budget;     // Maximum number of replica pages
+        int m_max_replicas_per_page;
+
+        int m_num_channels; // Number of channels (partitions) in the NUMA topology
+
+        // Free physical page tracking (one partition per channel)
+        PageAllocator m_page_allocator;
+
+        PageTable m_page_table; // VPN → PPN and channel of the primary copy, with the core-wise page accesses of the current window
+
+        std::vector<ReplicaSet> m_replica_sets;     // Indexed by PageTable::Entry::replica_set
+        std::vector<uint32_t> m_free_replica_sets;
+        std::unordered_map<Addr_t, uint32_t> m_replica_owner; // Replica PPN → replica set
+        size_t m_num_replicas = 0;
+
+        std::vector<int> m_last_write_window; // Per page table entry, -1 if not written since the entry was created
+
+        std::unordered_set<Addr_t> m_reserved_pages; // Reserved pages
+
+        size_t s_num_replications = 0;   // Replica pages created
+        size_t s_replica_reads = 0;      // Reads served by a replica
+        size_t s_replica_collapses = 0;  // Pages whose replicas were dropped by a write
+        size_t s_replica_drops = 0;      // Pages whose replicas were dropped because the page went cold
+        size_t s_replica_budget_full = 0; // Replicas not created because the budget was used up
+
+    public:
+        void init() override
+        {
+            // Seed for random number generator (can be specified via config)
+            int seed = param<int>("seed").desc("The seed for the random number generator used to allocate pages.").default_val(123);
+            m_allocator_rng.seed(seed);
+
+            // Get max physical address and page size from configuration
+            m_max_paddr = param<Addr_t>("max_addr").desc("Max physical address of the memory system.").required();
+            m_pagesize = param<Addr_t>("pagesize_KB").desc("Pagesize in KB.").default_val(4) << 10;
+            m_offsetbits = calc_log2(m_pagesize);
+
+            HOT_PAGE_THRESHOLD = param<size_t>("hot_page_threshold").desc("Threshold for hot pages.").required();
+            STABILITY_WINDOW = param<size_t>("window_size").desc("Window size.").required();
+            SHARER_THRESHOLD = param<size_t>("sharer_threshold").desc("Accesses to a page in a window for a core to count as one of its readers.").default_val(4);
+
+            // Calculate total number of physical pages
+            m_num_pages = m_max_paddr / m_pagesize;
+
+            // Initialize free physical page tracking
+            m_num_channels = numa_topology.get_num_channels();
+            m_page_allocator = PageAllocator(m_num_pages, m_num_channels);
+
+            m_replica_budget = param<size_t>("replica_budget").desc("Maximum number of replica pages in the whole memory.").default_val(4096);
+            m_max_replicas_per_page = param<int>("max_replicas_per_page").desc("Maximum number of replicas of one page.").default_val(m_num_channels - 1);
+
+            int tlb_size = param<int>("tlb_size").desc("Number of entries of the software TLB in front of the page table (a power of two).").default_val(64);
+            m_page_table = PageTable(numa_topology.get_num_cores(), tlb_size);
+
+            m_logger = Logging::create_logger("Hot_page_replication");
+
+            register_stat(s_num_replications).name("num_replications");
+            register_stat(s_replica_reads).name("replica_reads");
+            register_stat(s_replica_collapses).name("replica_collapses");
+            register_stat(s_replica_drops).name("replica_drops");
+            register_stat(s_replica_budget_full).name("replica_budget_full");
+        };
+
+        bool translate(Request &req) override
+        {
+            req.v_addr = req.addr;                 // Store the virtual address
+            Addr_t vpn = req.addr >> m_offsetbits; // Extract VPN from address
+            req.vpage = vpn;                       // Save VPN
+
+            access_counter++;
+            if (access_counter == STABILITY_WINDOW)
+            {
+                replicate_pages();
+                access_counter = 0;
+            }
+
+            // If the VPN is not translated yet, assign a new physical page
+            uint32_t id = m_page_table.find(vpn);
+            if (id == PageTable::npos)
+            {
+                int ch = find_best_channel(req.source_id);
+                Addr_t ppn = find_random_free_page(ch);
+                id = m_page_table.insert(vpn, ppn, ch);
+            }
+
+            // Update access count for this VPN by the requesting core
+            m_page_table.count(id, req.source_id);
+
+            auto &entry = m_page_table.get(id);
+            Addr_t ppn = entry.ppn;
+            if (req.type_id == Request::Type::Write)
+            {
+                // Replicas are read-only, the write goes to the primary copy and the replicas are dropped
+                if (entry.replica_set != PageTable::npos)
+                {
+                    drop_replicas(id);
+                    s_replica_collapses++;
+                }
+                if (m_last_write_window.size() <= id)
+                    m_last_write_window.resize(id + 1, -1);
+                m_last_write_window[id] = window_counter;
+            }
+            else if (entry.replica_set != PageTable::npos)
+            {
+                ppn = find_nearest_copy(entry, req.source_id);
+            }
+
+            // Compute the translated physical address (preserving offset bits)
+            Addr_t p_addr = (ppn << m_offsetbits) | (req.addr & ((1 << m_offsetbits) - 1));
+            DEBUG_LOG(DTRANSLATE, m_logger, "Translated Addr {}, VPN {} to Addr {}, PPN {}.", req.addr, vpn, p_addr, ppn);
+            req.addr = p_addr;
+            return true;
+        };
+
+        // Replicate the hot read-shared pages of the window and drop the replicas of the pages that went cold
+        void replicate_pages()
+        {
+            for (auto &set : m_replica_sets)
+            {
+                if (set.owner != PageTable::npos && !m_page_table.get_counts(set.owner))
+                {
+                    drop_replicas(set.owner);
+                    s_replica_drops++;
+                }
+            }
+
+            std::vector<int> channels;
+            const auto &touched = m_page_table.get_touched();
+            for (size_t i = 0; i < touched.size(); i++)
+            {
+                uint32_t id = touched[i];
+                if (id == PageTable::npos)
+                    continue;
+
+                if (!PagePlacement::is_hot_page(m_page_table, id, HOT_PAGE_THRESHOLD) || is_written(id))
+                    continue;
+
+                // The nearest channels of the readers of the page
+                const uint32_t *counts = m_page_table.get_counts(id);
+                channels.clear();
+                for (int core = 0; core < m_page_table.get_num_cores(); core++)
+                {
+                    if (counts[core] < SHARER_THRESHOLD)
+                        continue;
+                    int ch = find_best_channel(core);
+                    if (std::find(channels.begin(), channels.end(), ch) == channels.end())
+                        channels.push_back(ch);
+                }
+                if (channels.size() < 2)
+                    continue;
+
+                for (int ch : channels)
+                {
+                    if (has_copy(id, ch))
+                        continue;
+                    if (m_num_replicas >= m_replica_budget)
+                    {
+                        s_replica_budget_full++;
+                        break;
+                    }
+                    if (num_replicas(id) >= m_max_replicas_per_page)
+                        break;
+                    // Replicas only take free pages, they never evict a mapping
+                    if (m_page_allocator.get_num_free(ch) == 0)
+                        continue;
+                    add_replica(id, ch, m_page_allocator.allocate_random(ch, m_allocator_rng));
+                }
+            }
+
+            window_counter++;
+
+            m_page_table.end_window();
+        }
+
+        size_t find_best_channel(size_t core)
+        {
+            // Requesters outside the topology have no nearest channel
+            if (!numa_topology.is_core(core))
+                return 0;
+            return numa_topology.get_nearest_channel(core);
+        }
+
+        Addr_t find_nearest_copy(const PageTable::Entry &entry, int core)
+        {
+            if (!numa_topology.is_core(core))
+                return entry.ppn;
+
+            Addr_t ppn = entry.ppn;
+            int latency = numa_topology.get_latency(core, entry.channel);
+            for (const auto &replica : m_replica_sets[entry.replica_set].replicas)
+            {
+                if (numa_topology.get_latency(core, replica.channel) < latency)
+                {
+                    latency = numa_topology.get_latency(core, replica.channel);
+                    ppn = replica.ppn;
+                }
+            }
+            if (ppn != entry.ppn)
+            {
+                s_replica_reads++;
+                replicated_access_count++;
+            }
+            return ppn;
+        }
+
+        bool has_copy(uint32_t id, int ch)
+        {
+            auto &entry = m_page_table.get(id);
+            if (entry.channel == ch)
+                return true;
+            if (entry.replica_set == PageTable::npos)
+                return false;
+            const auto &replicas = m_replica_sets[entry.replica_set].replicas;
+            return std::any_of(replicas.begin(), replicas.end(), [ch](const Replica &r) { return r.channel == ch; });
+        }
+
+        int num_replicas(uint32_t id)
+        {
+            auto &entry = m_page_table.get(id);
+            return entry.replica_set == PageTable::npos ? 0 : m_replica_sets[entry.replica_set].replicas.size();
+        }
+
+        void add_replica(uint32_t id, int ch, Addr_t ppn)
+        {
+            auto &entry = m_page_table.get(id);
+            if (entry.replica_set == PageTable::npos)
+            {
+                if (m_free_replica_sets.empty())
+                {
+                    entry.replica_set = m_replica_sets.size();
+                    m_replica_sets.emplace_back();
+                }
+                else
+                {
+                    entry.replica_set = m_free_replica_sets.back();
+                    m_free_replica_sets.pop_back();
+                }
+                m_replica_sets[entry.replica_set].owner = id;
+            }
+            m_replica_sets[entry.replica_set].replicas.push_back({ch, ppn});
+            m_replica_owner[ppn] = entry.replica_set;
+            m_num_replicas++;
+            s_num_replications++;
+            DEBUG_LOG(DTRANSLATE, m_logger, "Replicated VPN {} to PPN {} in channel {} in window {}.", entry.vpn, ppn, ch, window_counter);
+        }
+
+        void drop_replicas(uint32_t id)
+        {
+            auto &entry = m_page_table.get(id);
+            ReplicaSet &set = m_replica_sets[entry.replica_set];
+            for (const auto &replica : set.replicas)
+            {
+                m_replica_owner.erase(replica.ppn);
+                m_page_allocator.free(replica.ppn);
+            }
+            m_num_replicas -= set.replicas.size();
+            set.replicas.clear();
+            set.owner = PageTable::npos;
+            m_free_replica_sets.push_back(entry.replica_set);
+            entry.replica_set = PageTable::npos;
+        }
+
+        Addr_t find_random_free_page(int ch)
+        {
+            return PagePlacement::find_random_free_page(m_page_allocator, m_page_table, m_reserved_pages, ch, m_allocator_rng,
+                                                        [this, ch](Addr_t victim_ppn, uint32_t victim) { evict(victim_ppn, victim, ch); });
+        }
+
+        // Called before an evicted page is handed over, the page table entry mapping it (if any) is removed afterwards
+        void evict(Addr_t victim_ppn, uint32_t victim, int ch)
+        {
+            // A replica victim only takes the replica away from its page
+            auto owner = m_replica_owner.find(victim_ppn);
+            if (owner != m_replica_owner.end())
+            {
+                uint32_t set_id = owner->second;
+                m_replica_owner.erase(owner);
+                ReplicaSet &set = m_replica_sets[set_id];
+                set.replicas.erase(std::find_if(set.replicas.begin(), set.replicas.end(), [victim_ppn](const Replica &r) { return r.ppn == victim_ppn; }));
+                m_num_replicas--;
+                if (set.replicas.empty())
+                {
+                    m_page_table.get(set.owner).replica_set = PageTable::npos;
+                    m_free_replica_sets.push_back(set_id);
+                    set.owner = PageTable::npos;
+                }
+                return;
+            }
+
+            // Drop the victim's replicas (if any, the page may have been left behind by a migration)
+            if (victim != PageTable::npos)
+            {
+                if (m_page_table.get(victim).replica_set != PageTable::npos)
+                    drop_replicas(victim);
+                if (victim < m_last_write_window.size())
+                    m_last_write_window[victim] = -1;
+                DEBUG_LOG(DTRANSLATE, m_logger, "Evicted VPN {} -> PPN {} from channel {}.", m_page_table.get(victim).vpn, victim_ppn, ch);
+            }
+        }
+
+        bool is_written(uint32_t id)
+        {
+            return id < m_last_write_window.size() && m_last_write_window[id] == window_counter;
+        }
+
+        bool reserve(const std::string &type, Addr_t addr) override
+        {
+            Addr_t ppn = addr >> m_offsetbits;
+            m_reserved_pages.insert(ppn);
+            m_page_allocator.allocate(ppn);
+            return true;
+        };
+
+        Addr_t get_max_addr() override
+        {
+            return m_max_paddr;
+        };
+    };
+
+} // namespace Ramulator
@@ -6,7 +6,11 @@
 #include "dram/dram.h"
 #include "base/base.h"
 #include "base/utils.h"
+#include "base/topology.h"
 #include "translation/translation.h"
+#include "translation/page_allocator.h"
+#include "translation/page_table.h"
+#include "translation/page_placement.h"
 #include "frontend/frontend.h"
 #include "memory_system/memory_system.h"
 #include <ctime>
@@ -35,19 +39,12 @@ namespace Ramulator
 
         size_t m_cost = 0;
 
-        size_t pages_per_channel;
+        int m_num_channels; // Number of channels (partitions) in the NUMA topology
 
-        // Free physical page tracking (divided into 8 partitions for 8 channels)
-        std::vector<std::vector<bool>> m_free_physical_pages2d;
-        std::vector<size_t> m_num_free_physical_pages_per_part;
+        // Free physical page tracking (one partition per channel)
+        PageAllocator m_page_allocator;
 
-        std::unordered_map<Addr_t, Addr_t> global_page_table; // VPN → PPN
-
-        std::unordered_map<Addr_t, Addr_t> reverse_page_table; // PPN → VPN (for fast eviction)
-
-        std::unordered_map<size_t, std::unordered_map<size_t, size_t>> page_access_counts_per_core; // Core-wise page accesses
-
-        // std::unordered_map<size_t, size_t> page_to_channel_mapping;                                 // VPN → Channel
+        PageTable m_page_table; // VPN → PPN and channel, with the core-wise page accesses of the current window
 
         std::unordered_set<Addr_t> m_reserved_pages; // Reserved pages
 
@@ -70,9 +67,11 @@ namespace Ramulator
             m_num_pages = m_max_paddr / m_pagesize;
 
             // Initialize free physical page tracking
-            pages_per_channel = m_num_pages / 8;
-            m_free_physical_pages2d = std::vector<std::vector<bool>>(8, std::vector<bool>(pages_per_channel, true));
-            m_num_free_physical_pages_per_part = std::vector<size_t>(8, pages_per_channel);
+            m_num_channels = numa_topology.get_num_channels();
+            m_page_allocator = PageAllocator(m_num_pages, m_num_channels);
+
+            int tlb_size = param<int>("tlb_size").desc("Number of entries of the software TLB in front of the page table (a power of two).").default_val(64);
+            m_page_table = PageTable(numa_topology.get_num_cores(), tlb_size);
 
             m_logger = Logging::create_logger("Local_to_requester");
 
@@ -88,60 +87,31 @@ namespace Ramulator
             Addr_t vpn = req.addr >> m_offsetbits; // Extract VPN from address
             req.vpage = vpn;                       // Save VPN
 
-            // Update access count for this VPN by the requesting core
-            // std::cout << " core id " << req.source_id << " VPN " << vpn << std::endl;
-            page_access_counts_per_core[vpn][req.source_id]++;
-
             migration_counter++;
             if (migration_counter == STABILITY_WINDOW)
             {
                 // migrate_pages();
+                m_page_table.end_window();
                 migration_counter = 0;
             }
 
-            // If the VPN is already translated, return the existing mapping
-            if (global_page_table.find(vpn) != global_page_table.end())
-            {
-                Addr_t p_addr = (global_page_table[vpn] << m_offsetbits) | (req.addr & ((1 << m_offsetbits) - 1));
-                req.addr = p_addr;
-                DEBUG_LOG(DTRANSLATE, m_logger, "Translated Addr {}, VPN {} to Addr {}, PPN {}.", req.addr, vpn, p_addr, global_page_table[vpn]);
-                return true;
-            }
-
-            // Otherwise, assign a new physical page
-            Addr_t ppn;
-            int ch = find_best_channel(req.source_id); // Choose best channel (here a simple hash is used)
-
-            if (m_num_free_physical_pages_per_part[ch] > 0) // Free pages available in chosen partition
-            {
-                bool flag = true;
-                while (flag)
-                {
-                    // Select a random page in the partition: random offset within partition plus partition start offset
-                    ppn = (m_allocator_rng() % pages_per_channel) + (ch * pages_per_channel);
-                    if (m_free_physical_pages2d[ch][ppn % pages_per_channel])
-                    {
-                        flag = false;
-                        m_free_physical_pages2d[ch][ppn % pages_per_channel] = false;
-                        m_num_free_physical_pages_per_part[ch]--;
-                    }
-                }
-            }
-            else
+            // If the VPN is not translated yet, assign a new physical page
+            uint32_t id = m_page_table.find(vpn);
+            if (id == PageTable::npos)
             {
-                // If no free page exists in the partition, evict a page and replace it
-                ppn = evict_and_replace_page(ch);
+                int ch = find_best_channel(req.source_id); // Choose best channel (here a simple hash is used)
+                Addr_t ppn = PagePlacement::find_random_free_page(m_page_allocator, m_page_table, m_reserved_pages, ch, m_allocator_rng);
+                id = m_page_table.insert(vpn, ppn, ch);
             }
 
-            // Update mappings: VPN to PPN and reverse
-            global_page_table[vpn] = ppn;
-            reverse_page_table[ppn] = vpn;
-            page_to_channel_mapping[vpn] = ch;
+            // Update access count for this VPN by the requesting core
+            m_page_table.count(id, req.source_id);
 
             // Compute the translated physical address (preserving offset bits)
-            Addr_t p_addr = (global_page_table[vpn] << m_offsetbits) | (req.addr & ((1 << m_offsetbits) - 1));
-            DEBUG_LOG(DTRANSLATE, m_logger, "Translated Addr {}, VPN {} to Addr {}, PPN {}.", req.addr, vpn, p_addr, global_page_table[vpn]);
-            // m_logger->info("Translated Addr {} requested by core {}, VPN {} to Addr {}, PPN {}, channel: {}", req.addr, req.source_id, vpn, p_addr, global_page_table[vpn], ch);
+            Addr_t ppn = m_page_table.get(id).ppn;
+            Addr_t p_addr = (ppn << m_offsetbits) | (req.addr & ((1 << m_offsetbits) - 1));
+            DEBUG_LOG(DTRANSLATE, m_logger, "Translated Addr {}, VPN {} to Addr {}, PPN {}.", req.addr, vpn, p_addr, ppn);
+            // m_logger->info("Translated Addr {} requested by core {}, VPN {} to Addr {}, PPN {}, channel: {}", req.addr, req.source_id, vpn, p_addr, ppn, m_page_table.get(id).channel);
             req.addr = p_addr;
             return true;
         };
@@ -152,34 +122,41 @@ namespace Ramulator
             // std::cout<<"Migration window: " << window_counter << std::endl;
             // std::cout << "Migrating called..." << std::endl;
             // std::cout << "Window: " << window_counter << std::endl;
-            for (const auto &entry : global_page_table)
+
+            // Only the pages accessed in this window can be hot (evictions during the loop mark their pages npos)
+            const auto &touched = m_page_table.get_touched();
+            for (size_t i = 0; i < touched.size(); i++)
             {
-                size_t vpn = entry.first;
-                Addr_t ppn = entry.second;
+                uint32_t id = touched[i];
+                if (id == PageTable::npos)
+                    continue;
+
+                auto &entry = m_page_table.get(id);
+                size_t vpn = entry.vpn;
+                Addr_t ppn = entry.ppn;
 
-                if (!is_hot_page(vpn))
+                if (!PagePlacement::is_hot_page(m_page_table, id, HOT_PAGE_THRESHOLD))
                     continue;
 
-                size_t most_frequent_core = find_most_frequent_core(vpn);
+                size_t most_frequent_core = find_most_frequent_core(id);
                 size_t best_channel = find_best_channel(most_frequent_core);
-                size_t current_channel = page_to_channel_mapping[vpn];
+                size_t current_channel = entry.channel;
 
                 if (best_channel == current_channel)
                     // m_logger->info("VPN {} is already in the best channel.", vpn);
                     // m_logger->info("Best channel: {}, Current channel: {}", best_channel, current_channel);
                     continue;
 
-                double gain = estimate_latency_gain(vpn, most_frequent_core);
+                double gain = estimate_latency_gain(id, most_frequent_core);
                 double cost = m_cost;
                 gain /= 1000;
 
                 if (gain > cost)
                 {
-                    ppn = find_random_free_page(best_channel);
-                    global_page_table[vpn] = ppn;
-                    page_to_channel_mapping[vpn] = best_channel;
+                    ppn = PagePlacement::find_random_free_page(m_page_allocator, m_page_table, m_reserved_pages, best_channel, m_allocator_rng);
+                    m_page_table.remap(id, ppn, best_channel);
                     m_logger->info("Migrated VPN {} to a new page in channel {}. in window {}", vpn, best_channel, window_counter);
-                    // m_logger->info("Migrated VPN {} to a new page in channel {}.", vpn, page_to_channel_mapping[vpn]);
+                    // m_logger->info("Migrated VPN {} to a new page in channel {}.", vpn, entry.channel);
                 }
                 else
                 {
@@ -190,22 +167,22 @@ namespace Ramulator
 
             window_counter++;
 
-            reset_all_page_access_counts();
+            m_page_table.end_window();
         }
 
-        size_t find_most_frequent_core(Addr_t vpn)
+        size_t find_most_frequent_core(uint32_t id)
         {
             size_t most_frequent_core = 0;
             size_t max_access_count = 0;
 
-            if (page_access_counts_per_core.find(vpn) != page_access_counts_per_core.end())
+            if (const uint32_t *counts = m_page_table.get_counts(id))
             {
-                for (const auto &entry : page_access_counts_per_core[vpn])
+                for (int core = 0; core < m_page_table.get_num_cores(); core++)
                 {
-                    if (entry.second > max_access_count)
+                    if (counts[core] > max_access_count)
                     {
-                        max_access_count = entry.second;
-                        most_frequent_core = entry.first;
+                        max_access_count = counts[core];
+                        most_frequent_core = core;
                     }
                 }
             }
@@ -214,94 +191,26 @@ namespace Ramulator
 
         size_t find_best_channel(size_t core)
         {
-            size_t best_channel = 0;
-            size_t min_latency = SIZE_MAX;
-
-            for (size_t channel = 0; channel < 8; channel++)
-
-            {
-                if (core_channel_latency_matrix[core][channel] < min_latency)
-                {
-                    min_latency = core_channel_latency_matrix[core][channel];
-                    best_channel = channel;
-                }
-            }
-            return best_channel;
+            // Requesters outside the topology have no nearest channel
+            if (!numa_topology.is_core(core))
+                return 0;
+            return numa_topology.get_nearest_channel(core);
         }
 
-        Addr_t find_random_free_page(int ch)
+        double estimate_latency_gain(uint32_t id, size_t current_core)
         {
+            const uint32_t *counts = m_page_table.get_counts(id);
+            if (!numa_topology.is_core(current_core) || !counts)
+                return 0;
 
-            // Check if any free page exists in this partition.
-            if (m_num_free_physical_pages_per_part[ch] == 0)
-            {
-                // Fallback to eviction (this should normally not happen if the caller checks first)
-                return evict_and_replace_page(ch);
-            }
-
-            Addr_t ppn;
-            while (true)
-            {
-                // Select a random offset within the partition and add the partition's starting offset.
-                ppn = (m_allocator_rng() % pages_per_channel) + (ch * pages_per_channel);
-                // Use modulo to index into the partition vector.
-                if (m_free_physical_pages2d[ch][ppn % pages_per_channel])
-                {
-                    m_free_physical_pages2d[ch][ppn % pages_per_channel] = false;
-                    m_num_free_physical_pages_per_part[ch]--;
-                    return ppn;
-                }
-            }
-        }
-
-        Addr_t evict_and_replace_page(int ch)
-        {
-            size_t pages_per_channel = m_num_pages / 8;
-            // Randomly select a victim page within the channel partition
-            Addr_t victim_ppn = (m_allocator_rng() % pages_per_channel) + (ch * pages_per_channel);
-
-            // Use the reverse page table for an O(1) lookup of the corresponding VPN
-            Addr_t victim_vpn = reverse_page_table[victim_ppn];
-
-            // Remove the victim's mapping from all tables
-            global_page_table.erase(victim_vpn);
-            reverse_page_table.erase(victim_ppn);
-            page_to_channel_mapping.erase(victim_vpn);
-
-            std::cout << "Evicted VPN: " << victim_vpn << " -> PPN: " << victim_ppn << " from channel " << ch << std::endl;
+            size_t current_channel = m_page_table.get(id).channel; // Track assigned channel
+            size_t best_channel = find_best_channel(current_core);
 
-            // Mark the victim page as free again
-            m_free_physical_pages2d[ch][victim_ppn % pages_per_channel] = true;
-            m_num_free_physical_pages_per_part[ch]++;
-
-            // Allocate and return a new free page from this partition
-            return find_random_free_page(ch);
-        }
-
-        // Determine if a page is "hot" (i.e., frequently accessed) based on a threshold.
-        bool is_hot_page(size_t vpn)
-        {
-            size_t total_access_count = 0;
-            for (const auto &[core_id, count] : page_access_counts_per_core[vpn])
-            {
-                total_access_count += count;
-            }
-            return total_access_count >= HOT_PAGE_THRESHOLD;
-        }
-
-        double estimate_latency_gain(size_t page_id, size_t current_core)
-        {
-            size_t current_channel = page_to_channel_mapping[page_id]; // Track assigned channel
-            size_t best_channel = std::distance(core_channel_latency_matrix[current_core],
-                std::min_element(core_channel_latency_matrix[current_core],
-                                 core_channel_latency_matrix[current_core] + 8))
-  ;
-
-            double current_latency = core_channel_latency_matrix[current_core][current_channel];
-            double new_latency = core_channel_latency_matrix[current_core][best_channel];
+            double current_latency = numa_topology.get_latency(current_core, current_channel);
+            double new_latency = numa_topology.get_latency(current_core, best_channel);
 
             // 📌 Predict future accesses using historical access count
-            size_t recent_accesses = page_access_counts_per_core[page_id][current_core];
+            size_t recent_accesses = counts[current_core];
             size_t predicted_accesses = recent_accesses * FUTURE_ACCESS_FACTOR; // Multiplier for future prediction
 
             double total_gain = (current_latency - new_latency) * predicted_accesses;
@@ -324,14 +233,11 @@ namespace Ramulator
 
             return cost_in_microseconds;
         }
-        void reset_all_page_access_counts()
-        {
-            page_access_counts_per_core.clear();
-        }
         bool reserve(const std::string &type, Addr_t addr) override
         {
             Addr_t ppn = addr >> m_offsetbits;
             m_reserved_pages.insert(ppn);
+            m_page_allocator.allocate(ppn);
             return true;
         };
 
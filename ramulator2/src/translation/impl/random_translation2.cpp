@@ -5,6 +5,7 @@
 
 #include "base/base.h"
 #include "translation/translation.h"
+#include "translation/page_allocator.h"
 #include "frontend/frontend.h"
 
 namespace Ramulator
@@ -24,8 +25,7 @@ namespace Ramulator
     int m_offsetbits;   // The number of bits for the page offset
     size_t m_num_pages; // The total number of physical pages
 
-    std::vector<bool> m_free_physical_pages; // The set of remaining pages.
-    size_t m_num_free_physical_pages;
+    PageAllocator m_free_physical_pages; // The set of remaining pages.
 
     using Translation_t = std::vector<std::unordered_map<Addr_t, Addr_t>>;
     Translation_t m_translation; // A vector of <vpn:ppn> maps, each core has its own map
@@ -46,8 +46,7 @@ namespace Ramulator
 
       // Initially, all physical pages are free
       m_num_pages = m_max_paddr / m_pagesize;
-      m_free_physical_pages.resize(m_num_pages, true);
-      m_num_free_physical_pages = m_num_pages;
+      m_free_physical_pages = PageAllocator(m_num_pages, 1);
 
       m_frontend = cast_parent<IFrontEnd>();
       m_translation.resize(m_frontend->get_num_cores());
@@ -67,7 +66,7 @@ namespace Ramulator
       if (target == global_page_table.end())
       {
         // No previous translation record. Assign a new page
-        if (m_num_free_physical_pages == 0)
+        if (m_free_physical_pages.get_num_free() == 0)
         {
           // We run out of physical pages. Randomly replace a previously assigned page (swap latency not modeled!)
           Addr_t ppn_to_replace = m_allocator_rng() % m_num_pages;
@@ -82,18 +81,9 @@ namespace Ramulator
         }
         else
         {
-          // We have available physical pages. Randomly assign one.
-          Addr_t ppn_to_assign = m_allocator_rng() % m_num_pages;
-          // We do not assign a reserved page or an already assigned page
-          while (
-              (m_reserved_pages.find(ppn_to_assign) != m_reserved_pages.end()) || (!m_free_physical_pages[ppn_to_assign]))
-          {
-            ppn_to_assign = m_allocator_rng() % m_num_pages;
-          }
+          // We have available physical pages. Randomly assign one (reserved pages are never free).
+          Addr_t ppn_to_assign = m_free_physical_pages.allocate_random(0, m_allocator_rng);
           global_page_table[vpn] = ppn_to_assign;
-          
-          m_num_free_physical_pages--;
-          m_free_physical_pages[ppn_to_assign] = false;
         }
 
         Addr_t p_addr = (global_page_table[vpn] << m_offsetbits) | (req.addr & ((1 << m_offsetbits) - 1));
@@ -121,6 +111,7 @@ namespace Ramulator
       Addr_t ppn = addr >> m_offsetbits;
       // Add page to reserved pages if it is not already reserved
       m_reserved_pages.insert(ppn);
+      m_free_physical_pages.allocate(ppn);
       // std::cout << "Reserved PPN " << ppn << "." << std::endl;
       return true;
     };
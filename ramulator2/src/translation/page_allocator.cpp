@@ -0,0 +1,138 @@
+#include <bit>
+
+#include "translation/page_allocator.h"
+#include "base/exception.h"
+
+namespace Ramulator {
+
+PageAllocator::PageAllocator(size_t num_pages, int num_partitions) {
+  if (num_partitions <= 0 || num_pages < size_t(num_partitions)) {
+    throw ConfigurationError("Cannot split {} physical pages into {} partitions!", num_pages, num_partitions);
+  }
+  m_pages_per_partition = num_pages / num_partitions;
+  m_partitions.resize(num_partitions);
+
+  for (auto& partition : m_partitions) {
+    // Size the levels bottom-up until a single word summarizes the whole partition
+    size_t num_bits = m_pages_per_partition;
+    do {
+      size_t num_words = (num_bits + 63) / 64;
+      std::vector<uint64_t> level(num_words, ~uint64_t(0));
+      if (num_bits % 64) {
+        level.back() = (uint64_t(1) << (num_bits % 64)) - 1;
+      }
+      partition.levels.push_back(std::move(level));
+      num_bits = num_words;
+    } while (num_bits > 1);
+    partition.num_free = m_pages_per_partition;
+  }
+}
+
+size_t PageAllocator::get_num_free() const {
+  size_t num_free = 0;
+  for (const auto& partition : m_partitions) {
+    num_free += partition.num_free;
+  }
+  return num_free;
+}
+
+bool PageAllocator::is_free(Addr_t ppn) const {
+  if (!is_valid(ppn)) {
+    return false;
+  }
+  size_t page = ppn % m_pages_per_partition;
+  return (m_partitions[get_partition(ppn)].levels[0][page / 64] >> (page % 64)) & 1;
+}
+
+Addr_t PageAllocator::allocate_random(int partition_id, std::mt19937_64& rng) {
+  Partition& partition = m_partitions[partition_id];
+  if (partition.num_free == 0) {
+    return npos;
+  }
+
+  size_t page = find_next_free(partition, rng() % m_pages_per_partition);
+  if (page == size_t(npos)) {
+    page = find_next_free(partition, 0);
+  }
+  set_bit(partition, page, false);
+  return partition_id * m_pages_per_partition + page;
+}
+
+Addr_t PageAllocator::allocate_contiguous(int partition_id) {
+  Partition& partition = m_partitions[partition_id];
+  if (partition.num_free == 0) {
+    return npos;
+  }
+
+  size_t page = find_next_free(partition, 0);
+  set_bit(partition, page, false);
+  return partition_id * m_pages_per_partition + page;
+}
+
+bool PageAllocator::allocate(Addr_t ppn) {
+  if (!is_free(ppn)) {
+    return false;
+  }
+  set_bit(m_partitions[get_partition(ppn)], ppn % m_pages_per_partition, false);
+  return true;
+}
+
+void PageAllocator::free(Addr_t ppn) {
+  if (!is_valid(ppn) || is_free(ppn)) {
+    return;
+  }
+  set_bit(m_partitions[get_partition(ppn)], ppn % m_pages_per_partition, true);
+}
+
+size_t PageAllocator::find_next_free(const Partition& partition, size_t page) const {
+  const auto& levels = partition.levels;
+
+  // Go up until a word has a set bit at or after the position
+  size_t pos = page;
+  size_t level = 0;
+  for (; level < levels.size(); level++) {
+    size_t word = pos / 64;
+    if (word >= levels[level].size()) {
+      return npos;
+    }
+    uint64_t bits = levels[level][word] & (~uint64_t(0) << (pos % 64));
+    if (bits) {
+      pos = word * 64 + std::countr_zero(bits);
+      break;
+    }
+    // Nothing left in this word, continue with the next word, i.e., the next bit one level up
+    pos = word + 1;
+  }
+  if (level == levels.size()) {
+    return npos;
+  }
+
+  // Go down following the first set bit of each word
+  while (level > 0) {
+    level--;
+    pos = pos * 64 + std::countr_zero(levels[level][pos]);
+  }
+  return pos;
+}
+
+void PageAllocator::set_bit(Partition& partition, size_t page, bool is_free) {
+  size_t pos = page;
+  for (auto& level : partition.levels) {
+    uint64_t& word = level[pos / 64];
+    uint64_t mask = uint64_t(1) << (pos % 64);
+    bool was_empty = (word == 0);
+    word = is_free ? (word | mask) : (word & ~mask);
+    // The level above only changes when this word becomes empty or stops being empty
+    if ((word == 0) == was_empty) {
+      break;
+    }
+    pos /= 64;
+  }
+  if (is_free) {
+    partition.num_free++;
+  } else {
+    partition.num_free--;
+  }
+}
+
+}        // namespace Ramulator
@@ -0,0 +1,78 @@
+#ifndef     RAMULATOR_TRANSLATION_PAGE_ALLOCATOR_H
+#define     RAMULATOR_TRANSLATION_PAGE_ALLOCATOR_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "base/type.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Free physical page tracking for the translations, split into equally sized partitions (e.g., one per channel).
+ *
+ * @details
+ * Each partition keeps a hierarchical bitmap: a bit in level 0 is set if its page is free, and a bit in level l + 1
+ * is set if the corresponding 64-bit word in level l is not zero. Finding the next free page from any position is a
+ * find-first-set on one word per level, so allocations take a constant number of steps (4 levels for 2^24 pages)
+ * no matter how full the partition is.
+ */
+class PageAllocator {
+  public:
+    static constexpr Addr_t npos = -1;
+
+  private:
+    struct Partition {
+      std::vector<std::vector<uint64_t>> levels;    // levels[0] are the free bits, the last level is a single word
+      size_t num_free = 0;
+    };
+
+    std::vector<Partition> m_partitions;
+    size_t m_pages_per_partition = 0;
+
+  public:
+    PageAllocator() = default;
+    /**
+     * @brief    Marks all pages free. Pages beyond num_pages / num_partitions * num_partitions are never handed out.
+     *           Throws if there are fewer pages than partitions.
+     */
+    PageAllocator(size_t num_pages, int num_partitions);
+
+    size_t get_pages_per_partition() const { return m_pages_per_partition; };
+    int get_partition(Addr_t ppn) const { return ppn / m_pages_per_partition; };
+    bool is_valid(Addr_t ppn) const { return ppn >= 0 && ppn < (Addr_t)(m_pages_per_partition * m_partitions.size()); };
+    size_t get_num_free(int partition) const { return m_partitions[partition].num_free; };
+    size_t get_num_free() const;
+    bool is_free(Addr_t ppn) const;
+
+    /**
+     * @brief    Allocates a random free page of the partition: a random page if it is free, otherwise the next free
+     *           page after it (wrapping around). Returns npos if the partition is full.
+     */
+    Addr_t allocate_random(int partition, std::mt19937_64& rng);
+
+    /**
+     * @brief    Allocates the lowest free page of the partition, so that consecutive allocations get contiguous pages
+     *           as long as nothing in between is taken. Returns npos if the partition is full.
+     */
+    Addr_t allocate_contiguous(int partition);
+
+    /**
+     * @brief    Allocates the given page. Returns false if it is not free.
+     */
+    bool allocate(Addr_t ppn);
+
+    /**
+     * @brief    Returns the given page to its partition.
+     */
+    void free(Addr_t ppn);
+
+  private:
+    size_t find_next_free(const Partition& partition, size_t page) const;
+    void set_bit(Partition& partition, size_t page, bool is_free);
+};
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_TRANSLATION_PAGE_ALLOCATOR_H
@@ -0,0 +1,48 @@
+#include "translation/page_placement.h"
+#include "base/exception.h"
+
+namespace Ramulator {
+
+namespace PagePlacement {
+
+Addr_t find_random_free_page(PageAllocator& allocator, PageTable& page_table, const std::unordered_set<Addr_t>& reserved_pages,
+                             int channel, std::mt19937_64& rng, const std::function<void(Addr_t, uint32_t)>& on_evict) {
+  if (allocator.get_num_free(channel) > 0) {
+    return allocator.allocate_random(channel, rng);
+  }
+
+  // Take the first page that is not reserved from a random position within the channel
+  size_t pages_per_channel = allocator.get_pages_per_partition();
+  size_t start = rng() % pages_per_channel;
+  for (size_t i = 0; i < pages_per_channel; i++) {
+    Addr_t victim_ppn = (start + i) % pages_per_channel + channel * pages_per_channel;
+    if (reserved_pages.find(victim_ppn) != reserved_pages.end()) {
+      continue;
+    }
+
+    // Remove the victim's mapping (if any, the page may have been left behind by a migration)
+    uint32_t victim = page_table.find_by_ppn(victim_ppn);
+    if (on_evict) {
+      on_evict(victim_ppn, victim);
+    }
+    if (victim != PageTable::npos) {
+      page_table.erase(victim);
+    }
+    return victim_ppn;
+  }
+  throw std::runtime_error(fmt::format("All physical pages of channel {} are reserved!", channel));
+}
+
+bool is_hot_page(const uint32_t* counts, int num_cores, size_t threshold) {
+  size_t total_access_count = 0;
+  if (counts) {
+    for (int core = 0; core < num_cores; core++) {
+      total_access_count += counts[core];
+    }
+  }
+  return total_access_count >= threshold;
+}
+
+}        // namespace PagePlacement
+
+}        // namespace Ramulator
@@ -0,0 +1,43 @@
+#ifndef     RAMULATOR_TRANSLATION_PAGE_PLACEMENT_H
+#define     RAMULATOR_TRANSLATION_PAGE_PLACEMENT_H
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <unordered_set>
+
+#include "base/type.h"
+#include "translation/page_allocator.h"
+#include "translation/page_table.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Page placement steps shared by the NUMA translations that keep one PageAllocator partition per channel
+ *           and their mappings in a PageTable (Local_to_requester, Dynamic_migration, Hot_page_replication).
+ */
+namespace PagePlacement {
+
+/**
+ * @brief    Allocates a random free page of the channel. If the channel is full, evicts a random page of the channel
+ *           that is not reserved instead: on_evict is called with the victim and the id of the entry mapping it
+ *           (PageTable::npos if none), then the mapping is removed and the victim is handed over still allocated.
+ *           Throws if every page of the channel is reserved.
+ */
+Addr_t find_random_free_page(PageAllocator& allocator, PageTable& page_table, const std::unordered_set<Addr_t>& reserved_pages,
+                             int channel, std::mt19937_64& rng, const std::function<void(Addr_t, uint32_t)>& on_evict = nullptr);
+
+/**
+ * @brief    Returns whether a page with the given per-core access counts of the current window (nullptr if it was not
+ *           touched) was accessed at least threshold times.
+ */
+bool is_hot_page(const uint32_t* counts, int num_cores, size_t threshold);
+inline bool is_hot_page(const PageTable& page_table, uint32_t id, size_t threshold) {
+  return is_hot_page(page_table.get_counts(id), page_table.get_num_cores(), threshold);
+};
+
+}        // namespace PagePlacement
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_TRANSLATION_PAGE_PLACEMENT_H
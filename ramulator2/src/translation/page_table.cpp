@@ -0,0 +1,138 @@
+#include "translation/page_table.h"
+#include "base/exception.h"
+
+namespace Ramulator {
+
+PageTable::Index::Index() {
+  m_slots.resize(1024);
+  m_mask = m_slots.size() - 1;
+}
+
+size_t PageTable::Index::home(Addr_t key) const {
+  uint64_t hash = (uint64_t)key * 0x9E3779B97F4A7C15ull;
+  return (hash ^ (hash >> 32)) & m_mask;
+}
+
+uint32_t PageTable::Index::find(Addr_t key) const {
+  for (size_t i = home(key);; i = (i + 1) & m_mask) {
+    const Slot& slot = m_slots[i];
+    if (slot.id == npos) {
+      return npos;
+    }
+    if (slot.key == key) {
+      return slot.id;
+    }
+  }
+}
+
+void PageTable::Index::insert(Addr_t key, uint32_t id) {
+  if ((m_size + 1) * 2 > m_slots.size()) {
+    grow();
+  }
+  size_t i = home(key);
+  while (m_slots[i].id != npos) {
+    i = (i + 1) & m_mask;
+  }
+  m_slots[i] = {key, id};
+  m_size++;
+}
+
+void PageTable::Index::erase(Addr_t key) {
+  size_t i = home(key);
+  while (m_slots[i].id != npos && m_slots[i].key != key) {
+    i = (i + 1) & m_mask;
+  }
+  if (m_slots[i].id == npos) {
+    return;
+  }
+
+  // Move back every following slot of the probe run that would otherwise become unreachable
+  size_t j = i;
+  while (true) {
+    j = (j + 1) & m_mask;
+    if (m_slots[j].id == npos) {
+      break;
+    }
+    size_t k = home(m_slots[j].key);
+    bool reachable = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+    if (!reachable) {
+      m_slots[i] = m_slots[j];
+      i = j;
+    }
+  }
+  m_slots[i].id = npos;
+  m_size--;
+}
+
+void PageTable::Index::grow() {
+  std::vector<Slot> slots(m_slots.size() * 2);
+  std::swap(slots, m_slots);
+  m_mask = m_slots.size() - 1;
+  m_size = 0;
+  for (const Slot& slot : slots) {
+    if (slot.id != npos) {
+      insert(slot.key, slot.id);
+    }
+  }
+}
+
+PageTable::PageTable(int num_cores, int tlb_size) : m_num_cores(num_cores) {
+  if (tlb_size <= 0 || (tlb_size & (tlb_size - 1)) != 0) {
+    throw ConfigurationError("The TLB size ({}) must be a power of two!", tlb_size);
+  }
+  m_tlb.resize(tlb_size);
+  m_tlb_mask = tlb_size - 1;
+}
+
+uint32_t PageTable::insert(Addr_t vpn, Addr_t ppn, int channel) {
+  uint32_t id;
+  if (m_free_ids.empty()) {
+    id = m_entries.size();
+    m_entries.emplace_back();
+  } else {
+    id = m_free_ids.back();
+    m_free_ids.pop_back();
+  }
+
+  Entry& entry = m_entries[id];
+  entry = Entry();
+  entry.vpn = vpn;
+  entry.ppn = ppn;
+  entry.channel = channel;
+  m_vpn_index.insert(vpn, id);
+  m_ppn_index.insert(ppn, id);
+  return id;
+}
+
+void PageTable::remap(uint32_t id, Addr_t ppn, int channel) {
+  Entry& entry = m_entries[id];
+  m_ppn_index.erase(entry.ppn);
+  m_ppn_index.insert(ppn, id);
+  entry.ppn = ppn;
+  entry.channel = channel;
+}
+
+void PageTable::erase(uint32_t id) {
+  Entry& entry = m_entries[id];
+  m_vpn_index.erase(entry.vpn);
+  m_ppn_index.erase(entry.ppn);
+
+  TLBEntry& tlb_entry = m_tlb[entry.vpn & m_tlb_mask];
+  if (tlb_entry.id == id) {
+    tlb_entry = TLBEntry();
+  }
+  if (entry.window == m_window) {
+    m_touched[entry.counter_row] = npos;
+  }
+
+  entry = Entry();
+  m_free_ids.push_back(id);
+}
+
+void PageTable::end_window() {
+  m_window++;
+  m_touched.clear();
+  m_counters.clear();
+}
+
+}        // namespace Ramulator
@@ -0,0 +1,142 @@
+#ifndef     RAMULATOR_TRANSLATION_PAGE_TABLE_H
+#define     RAMULATOR_TRANSLATION_PAGE_TABLE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "base/type.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    VPN -> PPN mappings of the NUMA translations, with per-core access counters for the current window.
+ *
+ * @details
+ * The mappings live in a dense array of entries with stable ids, indexed by VPN and by PPN through open-addressing
+ * (linear probing) hash tables. A small direct-mapped software TLB caches the entry ids of recently translated VPNs.
+ *
+ * Access counters are only kept for the pages touched in the current window: the first access in a window gives the
+ * page a row of fixed-width per-core counters, and ending the window simply drops all rows. A translation that hits
+ * in the TLB thus touches the TLB slot, the entry, and its counter row.
+ */
+class PageTable {
+  public:
+    static constexpr uint32_t npos = -1;
+
+    struct Entry {
+      Addr_t vpn = -1;
+      Addr_t ppn = -1;
+      int channel = -1;
+      int last_migration_window = -1;   // -1 if the page has never been migrated
+      uint32_t replica_set = npos;      // Read-only copies of the page in other channels, npos if none
+      uint32_t window = 0;              // The window the counter row belongs to, stale rows are ignored
+      uint32_t counter_row = 0;
+    };
+
+  private:
+    // Open-addressing Addr_t -> entry id map with backward-shift deletion
+    class Index {
+      private:
+        struct Slot {
+          Addr_t key;
+          uint32_t id = npos;
+        };
+        std::vector<Slot> m_slots;
+        size_t m_mask = 0;
+        size_t m_size = 0;
+
+      public:
+        Index();
+        uint32_t find(Addr_t key) const;
+        void insert(Addr_t key, uint32_t id);
+        void erase(Addr_t key);
+
+      private:
+        size_t home(Addr_t key) const;
+        void grow();
+    };
+
+    struct TLBEntry {
+      Addr_t vpn = -1;
+      uint32_t id = npos;
+    };
+
+    int m_num_cores = 0;
+
+    std::vector<Entry> m_entries;
+    std::vector<uint32_t> m_free_ids;
+    Index m_vpn_index;
+    Index m_ppn_index;
+
+    std::vector<TLBEntry> m_tlb;
+    size_t m_tlb_mask = 0;
+
+    uint32_t m_window = 1;
+    std::vector<uint32_t> m_counters;     // Per touched page x core
+    std::vector<uint32_t> m_touched;      // Entry id of each counter row, npos if the entry was erased since
+
+  public:
+    PageTable() = default;
+    PageTable(int num_cores, int tlb_size);
+
+    /**
+     * @brief    Returns the id of the entry mapping vpn, or npos.
+     */
+    uint32_t find(Addr_t vpn) {
+      TLBEntry& tlb_entry = m_tlb[vpn & m_tlb_mask];
+      if (tlb_entry.vpn == vpn) {
+        return tlb_entry.id;
+      }
+      uint32_t id = m_vpn_index.find(vpn);
+      if (id != npos) {
+        tlb_entry = {vpn, id};
+      }
+      return id;
+    };
+    uint32_t find_by_ppn(Addr_t ppn) const { return m_ppn_index.find(ppn); };
+    Entry& get(uint32_t id) { return m_entries[id]; };
+
+    uint32_t insert(Addr_t vpn, Addr_t ppn, int channel);
+    void remap(uint32_t id, Addr_t ppn, int channel);
+    void erase(uint32_t id);
+
+    /**
+     * @brief    Counts an access by core to the page. Accesses by requesters that are not cores are not counted.
+     */
+    void count(uint32_t id, int core) {
+      if (core < 0 || core >= m_num_cores) {
+        return;
+      }
+      Entry& entry = m_entries[id];
+      if (entry.window != m_window) {
+        entry.window = m_window;
+        entry.counter_row = m_touched.size();
+        m_touched.push_back(id);
+        m_counters.resize(m_counters.size() + m_num_cores, 0);
+      }
+      m_counters[entry.counter_row * m_num_cores + core]++;
+    };
+
+    /**
+     * @brief    Returns the per-core access counts of the page in the current window, or nullptr if it was not touched.
+     */
+    const uint32_t* get_counts(uint32_t id) const {
+      const Entry& entry = m_entries[id];
+      return entry.window == m_window ? &m_counters[entry.counter_row * m_num_cores] : nullptr;
+    };
+    int get_num_cores() const { return m_num_cores; };
+
+    /**
+     * @brief    Entry ids of the pages touched in the current window (npos for those erased since).
+     */
+    const std::vector<uint32_t>& get_touched() const { return m_touched; };
+
+    /**
+     * @brief    Starts a new window with all access counters at zero.
+     */
+    void end_window();
+};
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_TRANSLATION_PAGE_TABLE_H
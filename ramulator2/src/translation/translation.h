@@ -24,6 +24,19 @@ class ITranslation {
      */
     virtual bool translate(Request& req) = 0;
 
+    /**
+     * @brief    Ticks the translation once per frontend cycle, for work that does not wait for a request to
+     *           translate (e.g., resending rejected page copies).
+     * 
+     */
+    virtual void tick() {};
+
+    /**
+     * @brief    Whether tick() has nothing to do, the frontend only skips idle cycles if so.
+     * 
+     */
+    virtual bool is_idle() { return true; };
+
     /**
      * @brief    Reserves addr for the purpose indicated by type
      * 
@@ -1,13 +1,16 @@
 #include "address_home_lookup.h"
+#include "dram_placement.h"
 #include "log.h"
 
 AddressHomeLookup::AddressHomeLookup(UInt32 ahl_param,
       std::vector<core_id_t>& core_list,
-      UInt32 cache_block_size):
+      UInt32 cache_block_size,
+      DramPlacement* placement):
    m_ahl_param(ahl_param),
    m_ahl_mask((UInt64(1) << ahl_param) - 1),
    m_core_list(core_list),
-   m_cache_block_size(cache_block_size)
+   m_cache_block_size(cache_block_size),
+   m_placement(placement)
 {
 
    // Each Block Address is as follows:
@@ -23,11 +26,14 @@ AddressHomeLookup::AddressHomeLookup(UInt32 ahl_param,
 
 AddressHomeLookup::~AddressHomeLookup()
 {
-   // There is no memory to deallocate, so destructor has no function
+   DramPlacement::release(m_placement);
 }
 
-core_id_t AddressHomeLookup::getHome(IntPtr address) const
+core_id_t AddressHomeLookup::getHome(IntPtr address, core_id_t requester) const
 {
+   if (m_placement)
+      return m_core_list[m_placement->getModule(address, requester)];
+
    SInt32 module_num = (address >> m_ahl_param) % m_total_modules;
    LOG_ASSERT_ERROR(0 <= module_num && module_num < (SInt32) m_total_modules, "module_num(%i), total_modules(%u)", module_num, m_total_modules);
 
@@ -42,5 +48,9 @@ IntPtr AddressHomeLookup::getLinearBlock(IntPtr address) const
 
 IntPtr AddressHomeLookup::getLinearAddress(IntPtr address) const
 {
+   // Pages are not striped across the modules, so the address is already dense within a module
+   if (m_placement)
+      return address;
+
    return (getLinearBlock(address) << m_ahl_param) | (address & m_ahl_mask);
 }
@@ -5,6 +5,8 @@
 
 #include "fixed_types.h"
 
+class DramPlacement;
+
 /*
  * TODO abstract MMU stuff to a configure file to allow
  * user to specify number of memory controllers, and
@@ -23,10 +25,11 @@ class AddressHomeLookup
    public:
       AddressHomeLookup(UInt32 ahl_param,
             std::vector<core_id_t>& core_list,
-            UInt32 cache_block_size);
+            UInt32 cache_block_size,
+            DramPlacement* placement = NULL);
       ~AddressHomeLookup();
-      // Return home node for a given address
-      core_id_t getHome(IntPtr address) const;
+      // Return home node for a given address, requester is the core whose access is looked up (if known)
+      core_id_t getHome(IntPtr address, core_id_t requester = INVALID_CORE_ID) const;
       // Within home node, return unique, incrementing block number
       IntPtr getLinearBlock(IntPtr address) const;
       // Within home node, return unique, incrementing address to be used in cache set selection
@@ -38,6 +41,7 @@ class AddressHomeLookup
       std::vector<core_id_t> m_core_list;
       UInt32 m_total_modules;
       UInt32 m_cache_block_size;
+      DramPlacement* m_placement;   // Page-granular placement (DRAM controllers only), NULL for block interleaving
 };
 
 #endif /* __ADDRESS_HOME_LOOKUP_H__ */
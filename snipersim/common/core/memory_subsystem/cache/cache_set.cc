@@ -7,20 +7,76 @@
 #include "cache_set_random.h"
 #include "cache_set_round_robin.h"
 #include "cache_set_srrip.h"
+#include "cache_set_drrip.h"
+#include "cache_set_ship.h"
+#include "cache_set_hawkeye.h"
 #include "cache_base.h"
 #include "log.h"
 #include "simulator.h"
 #include "config.h"
 #include "config.hpp"
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+static SInt32 findTagScalar(const IntPtr* tags, UInt32 num_ways, IntPtr tag)
+{
+   for (SInt32 index = num_ways-1; index >= 0; index--)
+   {
+      if (tags[index] == tag)
+         return index;
+   }
+   return -1;
+}
+
+#if defined(__x86_64__)
+// Compares four tags at a time, from the highest ways down (the same order as findTagScalar)
+__attribute__((target("avx2")))
+static SInt32 findTagAVX2(const IntPtr* tags, UInt32 num_ways, IntPtr tag)
+{
+   UInt32 num_vector_ways = num_ways & ~3U;
+   for (SInt32 index = num_ways-1; index >= (SInt32)num_vector_ways; index--)
+   {
+      if (tags[index] == tag)
+         return index;
+   }
+
+   const __m256i needle = _mm256_set1_epi64x(tag);
+   for (SInt32 base = num_vector_ways - 4; base >= 0; base -= 4)
+   {
+      __m256i match = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)&tags[base]), needle);
+      int mask = _mm256_movemask_pd(_mm256_castsi256_pd(match));
+      if (mask)
+         return base + 31 - __builtin_clz(mask);
+   }
+   return -1;
+}
+#endif
+
+CacheSet::find_tag_func_t CacheSet::s_find_tag = CacheSet::selectFindTag();
+
+CacheSet::find_tag_func_t
+CacheSet::selectFindTag()
+{
+#if defined(__x86_64__)
+   __builtin_cpu_init(); // Runs before main()
+   if (__builtin_cpu_supports("avx2"))
+      return findTagAVX2;
+#endif
+   return findTagScalar;
+}
+
 CacheSet::CacheSet(CacheBase::cache_t cache_type,
       UInt32 associativity, UInt32 blocksize):
       m_associativity(associativity), m_blocksize(blocksize)
 {
    m_cache_block_info_array = new CacheBlockInfo*[m_associativity];
+   m_tags = new IntPtr[m_associativity];
    for (UInt32 i = 0; i < m_associativity; i++)
    {
       m_cache_block_info_array[i] = CacheBlockInfo::create(cache_type);
+      m_tags[i] = m_cache_block_info_array[i]->getTag();
    }
 
    if (Sim()->getFaultinjectionManager())
@@ -37,6 +93,7 @@ CacheSet::~CacheSet()
    for (UInt32 i = 0; i < m_associativity; i++)
       delete m_cache_block_info_array[i];
    delete [] m_cache_block_info_array;
+   delete [] m_tags;
    delete [] m_blocks;
 }
 
@@ -66,33 +123,41 @@ CacheSet::write_line(UInt32 line_index, UInt32 offset, Byte *in_buff, UInt32 byt
       updateReplacementIndex(line_index);
 }
 
-CacheBlockInfo*
-CacheSet::find(IntPtr tag, UInt32* line_index)
+SInt32
+CacheSet::findWay(IntPtr tag)
 {
-   for (SInt32 index = m_associativity-1; index >= 0; index--)
+   for (SInt32 index = s_find_tag(m_tags, m_associativity, tag); index >= 0; index = s_find_tag(m_tags, index, tag))
    {
       if (m_cache_block_info_array[index]->getTag() == tag)
-      {
-         if (line_index != NULL)
-            *line_index = index;
-         return (m_cache_block_info_array[index]);
-      }
+         return index;
+      // Invalidated through its CacheBlockInfo since it was inserted
+      m_tags[index] = m_cache_block_info_array[index]->getTag();
    }
-   return NULL;
+   return -1;
+}
+
+CacheBlockInfo*
+CacheSet::find(IntPtr tag, UInt32* line_index)
+{
+   SInt32 index = findWay(tag);
+   if (index < 0)
+      return NULL;
+
+   if (line_index != NULL)
+      *line_index = index;
+   return (m_cache_block_info_array[index]);
 }
 
 bool
 CacheSet::invalidate(IntPtr& tag)
 {
-   for (SInt32 index = m_associativity-1; index >= 0; index--)
-   {
-      if (m_cache_block_info_array[index]->getTag() == tag)
-      {
-         m_cache_block_info_array[index]->invalidate();
-         return true;
-      }
-   }
-   return false;
+   SInt32 index = findWay(tag);
+   if (index < 0)
+      return false;
+
+   m_cache_block_info_array[index]->invalidate();
+   m_tags[index] = m_cache_block_info_array[index]->getTag();
+   return true;
 }
 
 void
@@ -120,6 +185,8 @@ CacheSet::insert(CacheBlockInfo* cache_block_info, Byte* fill_buff, bool* evicti
 
    // FIXME: This is a hack. I dont know if this is the best way to do
    m_cache_block_info_array[index]->clone(cache_block_info);
+   m_tags[index] = m_cache_block_info_array[index]->getTag();
+   insertReplacementIndex(index);
 
    if (fill_buff != NULL && m_blocks != NULL)
       memcpy(&m_blocks[index * m_blocksize], (void*) fill_buff, m_blocksize);
@@ -135,7 +202,7 @@ CacheSet*
 CacheSet::createCacheSet(String cfgname, core_id_t core_id,
       String replacement_policy,
       CacheBase::cache_t cache_type,
-      UInt32 associativity, UInt32 blocksize, CacheSetInfo* set_info)
+      UInt32 associativity, UInt32 blocksize, CacheSetInfo* set_info, UInt32 set_index)
 {
    CacheBase::ReplacementPolicy policy = parsePolicyType(replacement_policy);
    switch(policy)
@@ -163,6 +230,15 @@ CacheSet::createCacheSet(String cfgname, core_id_t core_id,
       case CacheBase::SRRIP_QBS:
          return new CacheSetSRRIP(cfgname, core_id, cache_type, associativity, blocksize, dynamic_cast<CacheSetInfoLRU*>(set_info), getNumQBSAttempts(policy, cfgname, core_id));
 
+      case CacheBase::DRRIP:
+         return new CacheSetDRRIP(cache_type, associativity, blocksize, dynamic_cast<CacheSetInfoDRRIP*>(set_info), set_index);
+
+      case CacheBase::SHIP:
+         return new CacheSetSHiP(cache_type, associativity, blocksize, dynamic_cast<CacheSetInfoSHiP*>(set_info), set_index);
+
+      case CacheBase::HAWKEYE:
+         return new CacheSetHawkeye(cache_type, associativity, blocksize, dynamic_cast<CacheSetInfoHawkeye*>(set_info), set_index);
+
       case CacheBase::RANDOM:
          return new CacheSetRandom(cache_type, associativity, blocksize);
 
@@ -186,6 +262,12 @@ CacheSet::createCacheSetInfo(String name, String cfgname, core_id_t core_id, Str
       case CacheBase::SRRIP:
       case CacheBase::SRRIP_QBS:
          return new CacheSetInfoLRU(name, cfgname, core_id, associativity, getNumQBSAttempts(policy, cfgname, core_id));
+      case CacheBase::DRRIP:
+         return new CacheSetInfoDRRIP(name, cfgname, core_id);
+      case CacheBase::SHIP:
+         return new CacheSetInfoSHiP(name, cfgname, core_id);
+      case CacheBase::HAWKEYE:
+         return new CacheSetInfoHawkeye(name, cfgname, core_id);
       default:
          return NULL;
    }
@@ -225,6 +307,12 @@ CacheSet::parsePolicyType(String policy)
       return CacheBase::SRRIP;
    if (policy == "srrip_qbs")
       return CacheBase::SRRIP_QBS;
+   if (policy == "drrip")
+      return CacheBase::DRRIP;
+   if (policy == "ship")
+      return CacheBase::SHIP;
+   if (policy == "hawkeye")
+      return CacheBase::HAWKEYE;
    if (policy == "random")
       return CacheBase::RANDOM;
 
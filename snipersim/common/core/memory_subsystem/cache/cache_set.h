@@ -23,13 +23,18 @@ class CacheSet
 {
    public:
 
-      static CacheSet* createCacheSet(String cfgname, core_id_t core_id, String replacement_policy, CacheBase::cache_t cache_type, UInt32 associativity, UInt32 blocksize, CacheSetInfo* set_info = NULL);
+      static CacheSet* createCacheSet(String cfgname, core_id_t core_id, String replacement_policy, CacheBase::cache_t cache_type, UInt32 associativity, UInt32 blocksize, CacheSetInfo* set_info, UInt32 set_index);
       static CacheSetInfo* createCacheSetInfo(String name, String cfgname, core_id_t core_id, String replacement_policy, UInt32 associativity);
       static CacheBase::ReplacementPolicy parsePolicyType(String policy);
       static UInt8 getNumQBSAttempts(CacheBase::ReplacementPolicy, String cfgname, core_id_t core_id);
 
    protected:
       CacheBlockInfo** m_cache_block_info_array;
+      // Contiguous copy of the tag of each way, scanned by find() and invalidate() instead of the block objects.
+      // Blocks can be invalidated through the CacheBlockInfo* returned by find(), so a way may still hold the
+      // tag of a block that has since been invalidated (never the other way around): a match is checked
+      // against the block itself and stale tags are cleared.
+      IntPtr* m_tags;
       char* m_blocks;
       UInt32 m_associativity;
       UInt32 m_blocksize;
@@ -58,8 +63,18 @@ class CacheSet
 
       virtual UInt32 getReplacementIndex(CacheCntlr *cntlr) = 0;
       virtual void updateReplacementIndex(UInt32) = 0;
+      // Called by insert() once the new line is in place, for policies that choose the insertion position
+      virtual void insertReplacementIndex(UInt32 inserted_index) {}
 
       bool isValidReplacement(UInt32 index);
+
+   private:
+      // Returns the highest way below num_ways whose tag array entry is tag, or -1
+      typedef SInt32 (*find_tag_func_t)(const IntPtr* tags, UInt32 num_ways, IntPtr tag);
+      static find_tag_func_t s_find_tag;
+      static find_tag_func_t selectFindTag();
+
+      SInt32 findWay(IntPtr tag);
 };
 
 #endif /* CACHE_SET_H */
@@ -0,0 +1,55 @@
+#include "cache_set_drrip.h"
+#include "simulator.h"
+#include "config.hpp"
+#include "stats.h"
+#include "log.h"
+
+static std::vector<String> getDRRIPGroupNames()
+{
+   std::vector<String> names;
+   names.push_back("follower");
+   names.push_back("srrip-leader");
+   names.push_back("brrip-leader");
+   return names;
+}
+
+CacheSetInfoDRRIP::CacheSetInfoDRRIP(String name, String cfgname, core_id_t core_id)
+   : CacheSetInfoRRIP(name, core_id, getDRRIPGroupNames())
+   , m_rrip_numbits(Sim()->getCfg()->getIntArray(cfgname + "/drrip/bits", core_id))
+   , m_psel_max((1 << Sim()->getCfg()->getIntArray(cfgname + "/drrip/psel_bits", core_id)) - 1)
+   , m_brrip_interval(Sim()->getCfg()->getIntArray(cfgname + "/drrip/brrip_interval", core_id))
+   , m_psel(m_psel_max / 2)
+{
+   LOG_ASSERT_ERROR(m_brrip_interval > 0, "%s/drrip/brrip_interval must be positive", cfgname.c_str());
+   registerStatsMetric(name, core_id, "drrip-psel", &m_psel);
+}
+
+void
+CacheSetInfoDRRIP::leaderMiss(UInt32 group)
+{
+   if (group == 1 && m_psel < m_psel_max)
+      ++m_psel;
+   else if (group == 2 && m_psel > 0)
+      --m_psel;
+}
+
+CacheSetDRRIP::CacheSetDRRIP(
+      CacheBase::cache_t cache_type,
+      UInt32 associativity, UInt32 blocksize, CacheSetInfoDRRIP* set_info, UInt32 set_index)
+   : CacheSetRRIP(cache_type, associativity, blocksize, set_info->getNumBits(), set_info, set_index)
+   , m_group(CacheSetInfoRRIP::getLeaderGroup(m_set_index))
+   , m_set_info(set_info)
+{
+}
+
+UInt8
+CacheSetDRRIP::getInsertionRRPV(UInt32 inserted_index)
+{
+   m_set_info->leaderMiss(m_group);
+
+   bool brrip = m_group == 2 || (m_group == 0 && m_set_info->useBRRIP());
+   if (brrip && !m_set_info->brripLongInsertion())
+      return m_rrip_max;
+   else
+      return m_rrip_max - 1;
+}
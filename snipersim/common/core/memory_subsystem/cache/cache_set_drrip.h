@@ -0,0 +1,47 @@
+#ifndef CACHE_SET_DRRIP_H
+#define CACHE_SET_DRRIP_H
+
+#include "cache_set_rrip.h"
+
+class CacheSetInfoDRRIP : public CacheSetInfoRRIP
+{
+   public:
+      CacheSetInfoDRRIP(String name, String cfgname, core_id_t core_id);
+      virtual ~CacheSetInfoDRRIP() {}
+
+      UInt8 getNumBits() const { return m_rrip_numbits; }
+
+      // Leader sets of group 1 always insert as SRRIP, of group 2 as BRRIP; their misses move PSEL
+      void leaderMiss(UInt32 group);
+      bool useBRRIP() const { return m_psel > m_psel_max / 2; }
+      // Random rather than every n-th fill, which would alias with loops over the sets
+      bool brripLongInsertion() { return m_rand.next(m_brrip_interval) == 0; }
+
+   private:
+      const UInt8 m_rrip_numbits;
+      const UInt64 m_psel_max;
+      const UInt32 m_brrip_interval;
+      UInt64 m_psel;
+      Random m_rand;
+};
+
+// DRRIP: Dynamic Re-reference Interval Prediction [Jaleel et al., ISCA'10]
+//
+// Set dueling between SRRIP insertion (RRPV max-1) and bimodal BRRIP insertion (RRPV max, max-1 once every
+// brrip_interval fills), which protects the cache against scans and thrashing working sets.
+class CacheSetDRRIP : public CacheSetRRIP
+{
+   public:
+      CacheSetDRRIP(CacheBase::cache_t cache_type,
+            UInt32 associativity, UInt32 blocksize, CacheSetInfoDRRIP* set_info, UInt32 set_index);
+
+   protected:
+      UInt32 getGroup() const { return m_group; }
+      UInt8 getInsertionRRPV(UInt32 inserted_index);
+
+   private:
+      const UInt32 m_group;
+      CacheSetInfoDRRIP* m_set_info;
+};
+
+#endif /* CACHE_SET_DRRIP_H */
@@ -0,0 +1,173 @@
+#include "cache_set_hawkeye.h"
+#include "simulator.h"
+#include "config.hpp"
+#include "stats.h"
+#include "utils.h"
+#include "log.h"
+
+static std::vector<String> getHawkeyeGroupNames()
+{
+   std::vector<String> names;
+   names.push_back("follower");
+   names.push_back("sampled");
+   return names;
+}
+
+CacheSetInfoHawkeye::CacheSetInfoHawkeye(String name, String cfgname, core_id_t core_id)
+   : CacheSetInfoRRIP(name, core_id, getHawkeyeGroupNames())
+   , m_rrip_numbits(Sim()->getCfg()->getIntArray(cfgname + "/hawkeye/bits", core_id))
+   , m_history_length(Sim()->getCfg()->getIntArray(cfgname + "/hawkeye/history_length", core_id))
+   , m_counter_max((1 << Sim()->getCfg()->getIntArray(cfgname + "/hawkeye/counter_bits", core_id)) - 1)
+   , m_optgen_accesses(0)
+   , m_optgen_hits(0)
+   , m_averse_inserts(0)
+{
+   UInt32 table_size = Sim()->getCfg()->getIntArray(cfgname + "/hawkeye/table_size", core_id);
+   UInt32 region_lines = Sim()->getCfg()->getIntArray(cfgname + "/hawkeye/region_lines", core_id);
+   LOG_ASSERT_ERROR(isPower2(table_size), "%s/hawkeye/table_size (%u) must be a power of two", cfgname.c_str(), table_size);
+   LOG_ASSERT_ERROR(isPower2(region_lines), "%s/hawkeye/region_lines (%u) must be a power of two", cfgname.c_str(), region_lines);
+   LOG_ASSERT_ERROR(m_history_length > 0, "%s/hawkeye/history_length must be positive", cfgname.c_str());
+   m_region_bits = floorLog2(region_lines);
+
+   // Start out weakly cache-friendly
+   m_predictor.resize(table_size, m_counter_max / 2 + 1);
+
+   registerStatsMetric(name, core_id, "optgen-accesses", &m_optgen_accesses);
+   registerStatsMetric(name, core_id, "optgen-hits", &m_optgen_hits);
+   registerStatsMetric(name, core_id, "hawkeye-averse-inserts", &m_averse_inserts);
+}
+
+void
+CacheSetInfoHawkeye::train(UInt32 signature, bool opt_hit)
+{
+   ++m_optgen_accesses;
+   if (opt_hit)
+   {
+      ++m_optgen_hits;
+      if (m_predictor[signature] < m_counter_max)
+         ++m_predictor[signature];
+   }
+   else if (m_predictor[signature] > 0)
+   {
+      --m_predictor[signature];
+   }
+}
+
+CacheSetHawkeye::CacheSetHawkeye(
+      CacheBase::cache_t cache_type,
+      UInt32 associativity, UInt32 blocksize, CacheSetInfoHawkeye* set_info, UInt32 set_index)
+   : CacheSetRRIP(cache_type, associativity, blocksize, set_info->getNumBits(), set_info, set_index)
+   , m_optgen(NULL)
+   , m_set_info(set_info)
+{
+   m_signatures = new UInt32[m_associativity];
+   m_friendly = new bool[m_associativity];
+   for (UInt32 i = 0; i < m_associativity; i++)
+   {
+      m_signatures[i] = 0;
+      m_friendly[i] = false;
+   }
+
+   if (CacheSetInfoRRIP::getLeaderGroup(m_set_index) != 0)
+   {
+      m_optgen = new OptGen();
+      m_optgen->time = 0;
+      m_optgen->occupancy.resize(m_set_info->getHistoryLength() * m_associativity, 0);
+   }
+}
+
+CacheSetHawkeye::~CacheSetHawkeye()
+{
+   delete [] m_signatures;
+   delete [] m_friendly;
+   if (m_optgen)
+      delete m_optgen;
+}
+
+void
+CacheSetHawkeye::optgenAccess(IntPtr tag, UInt32 signature)
+{
+   const UInt64 window = m_optgen->occupancy.size();
+   const UInt64 now = m_optgen->time;
+
+   std::unordered_map<IntPtr, std::pair<UInt64, UInt32> >::iterator it = m_optgen->last_access.find(tag);
+   if (it != m_optgen->last_access.end())
+   {
+      UInt64 last = it->second.first;
+      // OPT would have kept the line since its last access if the set had room for it all along
+      bool opt_hit = now - last < window;
+      for (UInt64 t = last; opt_hit && t < now; ++t)
+      {
+         if (m_optgen->occupancy[t % window] >= m_associativity)
+            opt_hit = false;
+      }
+      if (opt_hit)
+      {
+         for (UInt64 t = last; t < now; ++t)
+            ++m_optgen->occupancy[t % window];
+      }
+      m_set_info->train(it->second.second, opt_hit);
+   }
+
+   m_optgen->occupancy[now % window] = 0;
+   m_optgen->last_access[tag] = std::make_pair(now, signature);
+   ++m_optgen->time;
+
+   // Forget lines that were last accessed before the window, OPT can no longer hit on them
+   if (m_optgen->last_access.size() > 2 * window)
+   {
+      for (it = m_optgen->last_access.begin(); it != m_optgen->last_access.end();)
+      {
+         if (m_optgen->time - it->second.first > window)
+            it = m_optgen->last_access.erase(it);
+         else
+            ++it;
+      }
+   }
+}
+
+// Returns the RRPV for the line in way index after an access to it, ageing the other cache-friendly lines
+UInt8
+CacheSetHawkeye::predict(UInt32 index)
+{
+   m_friendly[index] = m_set_info->predictFriendly(m_signatures[index]);
+   if (!m_friendly[index])
+      return m_rrip_max;
+
+   for (UInt32 i = 0; i < m_associativity; i++)
+   {
+      if (i != index && m_rrip_bits[i] < m_rrip_max - 1)
+         m_rrip_bits[i]++;
+   }
+   return 0;
+}
+
+UInt8
+CacheSetHawkeye::getInsertionRRPV(UInt32 inserted_index)
+{
+   m_signatures[inserted_index] = m_set_info->getSignature(m_tags[inserted_index]);
+   if (m_optgen)
+      optgenAccess(m_tags[inserted_index], m_signatures[inserted_index]);
+
+   UInt8 rrpv = predict(inserted_index);
+   if (!m_friendly[inserted_index])
+      m_set_info->averseInsertion();
+   return rrpv;
+}
+
+void
+CacheSetHawkeye::onHit(UInt32 accessed_index)
+{
+   if (m_optgen)
+      optgenAccess(m_tags[accessed_index], m_signatures[accessed_index]);
+
+   m_rrip_bits[accessed_index] = predict(accessed_index);
+}
+
+void
+CacheSetHawkeye::onEvict(UInt32 evicted_index)
+{
+   // Evicting a line that was predicted to be kept: its signature is less friendly than thought
+   if (m_friendly[evicted_index])
+      m_set_info->detrain(m_signatures[evicted_index]);
+}
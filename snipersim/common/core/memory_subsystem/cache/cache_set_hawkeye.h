@@ -0,0 +1,69 @@
+#ifndef CACHE_SET_HAWKEYE_H
+#define CACHE_SET_HAWKEYE_H
+
+#include "cache_set_rrip.h"
+
+#include <vector>
+#include <unordered_map>
+
+class CacheSetInfoHawkeye : public CacheSetInfoRRIP
+{
+   public:
+      CacheSetInfoHawkeye(String name, String cfgname, core_id_t core_id);
+      virtual ~CacheSetInfoHawkeye() {}
+
+      UInt8 getNumBits() const { return m_rrip_numbits; }
+      UInt32 getHistoryLength() const { return m_history_length; }
+
+      UInt32 getSignature(IntPtr tag) const { return CacheSetInfoRRIP::getSignature(tag, m_region_bits, m_predictor.size()); }
+      bool predictFriendly(UInt32 signature) const { return m_predictor[signature] > m_counter_max / 2; }
+      void train(UInt32 signature, bool opt_hit);
+      void detrain(UInt32 signature) { if (m_predictor[signature] > 0) --m_predictor[signature]; }
+      void averseInsertion() { ++m_averse_inserts; }
+
+   private:
+      const UInt8 m_rrip_numbits;
+      const UInt32 m_history_length;
+      UInt32 m_region_bits;
+      const UInt8 m_counter_max;
+      std::vector<UInt8> m_predictor;    // Shared by all sets of the cache, trained by the sampled sets
+      UInt64 m_optgen_accesses, m_optgen_hits, m_averse_inserts;
+};
+
+// Hawkeye [Jain and Lin, ISCA'16]
+//
+// The sampled sets replay their accesses through OPTgen, which decides whether Belady's optimal policy would
+// have hit on each reuse within history_length x associativity accesses to the set. Its verdicts train a
+// predictor per signature (the memory region of the line, as the caches do not see the PC). Lines predicted
+// cache-friendly are inserted and promoted at RRPV 0, cache-averse lines at the maximum RRPV so they go first.
+class CacheSetHawkeye : public CacheSetRRIP
+{
+   public:
+      CacheSetHawkeye(CacheBase::cache_t cache_type,
+            UInt32 associativity, UInt32 blocksize, CacheSetInfoHawkeye* set_info, UInt32 set_index);
+      ~CacheSetHawkeye();
+
+   protected:
+      UInt32 getGroup() const { return m_optgen ? 1 : 0; }
+      UInt8 getInsertionRRPV(UInt32 inserted_index);
+      void onHit(UInt32 accessed_index);
+      void onEvict(UInt32 evicted_index);
+
+   private:
+      struct OptGen
+      {
+         UInt64 time;                        // Accesses to the set so far
+         std::vector<UInt8> occupancy;       // Lines OPT keeps cached at each of the last history_length x associativity accesses
+         std::unordered_map<IntPtr, std::pair<UInt64, UInt32> > last_access;   // Tag -> time and signature of its last access
+      };
+
+      UInt32* m_signatures;
+      bool* m_friendly;
+      OptGen* m_optgen;                      // Only in sampled sets
+      CacheSetInfoHawkeye* m_set_info;
+
+      void optgenAccess(IntPtr tag, UInt32 signature);
+      UInt8 predict(UInt32 index);
+};
+
+#endif /* CACHE_SET_HAWKEYE_H */
@@ -0,0 +1,107 @@
+#include "cache_set_rrip.h"
+#include "stats.h"
+#include "log.h"
+
+CacheSetInfoRRIP::CacheSetInfoRRIP(String name, core_id_t core_id, const std::vector<String>& group_names)
+   : m_hits(group_names.size(), 0)
+   , m_fills(group_names.size(), 0)
+   , m_writebacks(group_names.size(), 0)
+{
+   for (UInt32 i = 0; i < group_names.size(); ++i)
+   {
+      registerStatsMetric(name, core_id, group_names[i] + "-hits", &m_hits[i]);
+      registerStatsMetric(name, core_id, group_names[i] + "-fills", &m_fills[i]);
+      registerStatsMetric(name, core_id, group_names[i] + "-writebacks", &m_writebacks[i]);
+   }
+}
+
+UInt32
+CacheSetInfoRRIP::getLeaderGroup(UInt32 set_index)
+{
+   UInt32 offset = set_index & 31;
+   UInt32 constituency = (set_index >> 5) & 31;
+   if (offset == constituency)
+      return 1;
+   if (offset == (~constituency & 31))
+      return 2;
+   return 0;
+}
+
+UInt32
+CacheSetInfoRRIP::getSignature(IntPtr tag, UInt32 region_bits, UInt32 num_signatures)
+{
+   UInt64 hash = (tag >> region_bits) * 0x9E3779B97F4A7C15ull;
+   return (hash >> 32) & (num_signatures - 1);
+}
+
+CacheSetRRIP::CacheSetRRIP(
+      CacheBase::cache_t cache_type,
+      UInt32 associativity, UInt32 blocksize, UInt8 rrip_numbits, CacheSetInfoRRIP* set_info, UInt32 set_index)
+   : CacheSet(cache_type, associativity, blocksize)
+   , m_rrip_max((1 << rrip_numbits) - 1)
+   , m_replacement_pointer(0)
+   , m_set_index(set_index)
+   , m_set_info(set_info)
+{
+   LOG_ASSERT_ERROR(rrip_numbits > 0 && rrip_numbits <= 7, "Invalid number of RRIP bits %d", rrip_numbits);
+
+   m_rrip_bits = new UInt8[m_associativity];
+   for (UInt32 i = 0; i < m_associativity; i++)
+      m_rrip_bits[i] = m_rrip_max;
+}
+
+CacheSetRRIP::~CacheSetRRIP()
+{
+   delete [] m_rrip_bits;
+}
+
+UInt32
+CacheSetRRIP::getReplacementIndex(CacheCntlr *cntlr)
+{
+   for (UInt32 i = 0; i < m_associativity; i++)
+   {
+      if (!m_cache_block_info_array[i]->isValid())
+         return i;
+   }
+
+   for(UInt32 j = 0; j <= m_rrip_max; ++j)
+   {
+      for (UInt32 i = 0; i < m_associativity; i++)
+      {
+         UInt32 index = m_replacement_pointer;
+         m_replacement_pointer = (m_replacement_pointer + 1) % m_associativity;
+
+         if (m_rrip_bits[index] >= m_rrip_max && isValidReplacement(index))
+         {
+            CacheState::cstate_t cstate = m_cache_block_info_array[index]->getCState();
+            if (cstate == CacheState::MODIFIED || cstate == CacheState::OWNED)
+               m_set_info->writeback(getGroup());
+            onEvict(index);
+            return index;
+         }
+      }
+
+      // Increment all RRIP counters until one hits RRIP_MAX
+      for (UInt32 i = 0; i < m_associativity; i++)
+      {
+         if (m_rrip_bits[i] < m_rrip_max)
+            m_rrip_bits[i]++;
+      }
+   }
+
+   LOG_PRINT_ERROR("Error finding replacement index");
+}
+
+void
+CacheSetRRIP::updateReplacementIndex(UInt32 accessed_index)
+{
+   m_set_info->hit(getGroup());
+   onHit(accessed_index);
+}
+
+void
+CacheSetRRIP::insertReplacementIndex(UInt32 inserted_index)
+{
+   m_set_info->fill(getGroup());
+   m_rrip_bits[inserted_index] = getInsertionRRPV(inserted_index);
+}
@@ -0,0 +1,60 @@
+#ifndef CACHE_SET_RRIP_H
+#define CACHE_SET_RRIP_H
+
+#include "cache_set.h"
+
+#include <vector>
+
+// Per-cache state shared by the sets of the adaptive RRIP policies (drrip, ship, hawkeye): the choice of
+// sampled (leader) sets, and hit, fill and writeback counts per group of sets. In the last-level
+// cache, fills and dirty evictions are the DRAM reads and writes caused by the policy.
+class CacheSetInfoRRIP : public CacheSetInfo
+{
+   public:
+      CacheSetInfoRRIP(String name, core_id_t core_id, const std::vector<String>& group_names);
+      virtual ~CacheSetInfoRRIP() {}
+
+      // Complement-select: in every 1024 sets, 32 are sampled for leader group 1 and 32 for group 2 (0 = follower)
+      static UInt32 getLeaderGroup(UInt32 set_index);
+      // Signature of the memory region of a line (2^region_bits lines), used by the reuse predictors in place of
+      // the PC of the access, which the caches do not see
+      static UInt32 getSignature(IntPtr tag, UInt32 region_bits, UInt32 num_signatures);
+
+      void hit(UInt32 group) { ++m_hits[group]; }
+      void fill(UInt32 group) { ++m_fills[group]; }
+      void writeback(UInt32 group) { ++m_writebacks[group]; }
+
+   private:
+      std::vector<UInt64> m_hits, m_fills, m_writebacks;
+};
+
+// Re-reference Interval Prediction sets with a per-policy insertion and promotion, see CacheSetDRRIP,
+// CacheSetSHiP and CacheSetHawkeye. Victims are the first line at the maximum RRPV from a rotating pointer,
+// like CacheSetSRRIP (without QBS).
+class CacheSetRRIP : public CacheSet
+{
+   public:
+      CacheSetRRIP(CacheBase::cache_t cache_type,
+            UInt32 associativity, UInt32 blocksize, UInt8 rrip_numbits, CacheSetInfoRRIP* set_info, UInt32 set_index);
+      virtual ~CacheSetRRIP();
+
+      UInt32 getReplacementIndex(CacheCntlr *cntlr);
+      void updateReplacementIndex(UInt32 accessed_index);
+      void insertReplacementIndex(UInt32 inserted_index);
+
+   protected:
+      const UInt8 m_rrip_max;
+      UInt8* m_rrip_bits;
+      UInt32 m_replacement_pointer;
+      const UInt32 m_set_index;           // Index in the cache, not the ATD: ATDs only build their sampled sets
+
+      virtual UInt32 getGroup() const = 0;
+      virtual UInt8 getInsertionRRPV(UInt32 inserted_index) = 0;
+      virtual void onHit(UInt32 accessed_index) { m_rrip_bits[accessed_index] = 0; }
+      virtual void onEvict(UInt32 evicted_index) {}
+
+   private:
+      CacheSetInfoRRIP* m_set_info;
+};
+
+#endif /* CACHE_SET_RRIP_H */
@@ -0,0 +1,88 @@
+#include "cache_set_ship.h"
+#include "simulator.h"
+#include "config.hpp"
+#include "stats.h"
+#include "utils.h"
+#include "log.h"
+
+CacheSetInfoSHiP::CacheSetInfoSHiP(String name, String cfgname, core_id_t core_id)
+   : CacheSetInfoDRRIP(name, cfgname, core_id)
+   , m_counter_max((1 << Sim()->getCfg()->getIntArray(cfgname + "/ship/counter_bits", core_id)) - 1)
+   , m_distant_inserts(0)
+{
+   UInt32 table_size = Sim()->getCfg()->getIntArray(cfgname + "/ship/table_size", core_id);
+   UInt32 region_lines = Sim()->getCfg()->getIntArray(cfgname + "/ship/region_lines", core_id);
+   LOG_ASSERT_ERROR(isPower2(table_size), "%s/ship/table_size (%u) must be a power of two", cfgname.c_str(), table_size);
+   LOG_ASSERT_ERROR(isPower2(region_lines), "%s/ship/region_lines (%u) must be a power of two", cfgname.c_str(), region_lines);
+   m_region_bits = floorLog2(region_lines);
+
+   // Start out weakly predicting reuse, so that insertion is as DRRIP until a signature has been seen to be dead
+   m_shct.resize(table_size, 1);
+
+   registerStatsMetric(name, core_id, "ship-distant-inserts", &m_distant_inserts);
+}
+
+void
+CacheSetInfoSHiP::train(UInt32 signature, bool reused)
+{
+   if (reused && m_shct[signature] < m_counter_max)
+      ++m_shct[signature];
+   else if (!reused && m_shct[signature] > 0)
+      --m_shct[signature];
+}
+
+CacheSetSHiP::CacheSetSHiP(
+      CacheBase::cache_t cache_type,
+      UInt32 associativity, UInt32 blocksize, CacheSetInfoSHiP* set_info, UInt32 set_index)
+   : CacheSetDRRIP(cache_type, associativity, blocksize, set_info, set_index)
+   , m_set_info(set_info)
+{
+   m_signatures = new UInt32[m_associativity];
+   m_reused = new bool[m_associativity];
+   for (UInt32 i = 0; i < m_associativity; i++)
+   {
+      m_signatures[i] = 0;
+      m_reused[i] = false;
+   }
+}
+
+CacheSetSHiP::~CacheSetSHiP()
+{
+   delete [] m_signatures;
+   delete [] m_reused;
+}
+
+UInt8
+CacheSetSHiP::getInsertionRRPV(UInt32 inserted_index)
+{
+   // Always ask DRRIP, so that the leader sets keep training PSEL
+   UInt8 rrpv = CacheSetDRRIP::getInsertionRRPV(inserted_index);
+
+   m_signatures[inserted_index] = m_set_info->getSignature(m_tags[inserted_index]);
+   m_reused[inserted_index] = false;
+
+   if (!m_set_info->predictReuse(m_signatures[inserted_index]))
+   {
+      m_set_info->distantInsertion();
+      return m_rrip_max;
+   }
+   return rrpv;
+}
+
+void
+CacheSetSHiP::onHit(UInt32 accessed_index)
+{
+   if (!m_reused[accessed_index])
+   {
+      m_reused[accessed_index] = true;
+      m_set_info->train(m_signatures[accessed_index], true);
+   }
+   CacheSetDRRIP::onHit(accessed_index);
+}
+
+void
+CacheSetSHiP::onEvict(UInt32 evicted_index)
+{
+   if (!m_reused[evicted_index])
+      m_set_info->train(m_signatures[evicted_index], false);
+}
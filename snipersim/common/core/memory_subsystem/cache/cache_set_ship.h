@@ -0,0 +1,48 @@
+#ifndef CACHE_SET_SHIP_H
+#define CACHE_SET_SHIP_H
+
+#include "cache_set_drrip.h"
+
+#include <vector>
+
+class CacheSetInfoSHiP : public CacheSetInfoDRRIP
+{
+   public:
+      CacheSetInfoSHiP(String name, String cfgname, core_id_t core_id);
+      virtual ~CacheSetInfoSHiP() {}
+
+      UInt32 getSignature(IntPtr tag) const { return CacheSetInfoRRIP::getSignature(tag, m_region_bits, m_shct.size()); }
+      bool predictReuse(UInt32 signature) const { return m_shct[signature] > 0; }
+      void train(UInt32 signature, bool reused);
+      void distantInsertion() { ++m_distant_inserts; }
+
+   private:
+      UInt32 m_region_bits;
+      const UInt8 m_counter_max;
+      std::vector<UInt8> m_shct;    // Signature History Counter Table, shared by all sets of the cache
+      UInt64 m_distant_inserts;
+};
+
+// SHiP: Signature-based Hit Predictor [Wu et al., MICRO'11], on top of DRRIP
+//
+// Lines whose signature has not seen a hit before eviction recently (its SHCT counter is zero) are inserted at
+// the maximum RRPV, others as DRRIP would. The signature is the memory region of the line (SHiP-Mem).
+class CacheSetSHiP : public CacheSetDRRIP
+{
+   public:
+      CacheSetSHiP(CacheBase::cache_t cache_type,
+            UInt32 associativity, UInt32 blocksize, CacheSetInfoSHiP* set_info, UInt32 set_index);
+      ~CacheSetSHiP();
+
+   protected:
+      UInt8 getInsertionRRPV(UInt32 inserted_index);
+      void onHit(UInt32 accessed_index);
+      void onEvict(UInt32 evicted_index);
+
+   private:
+      UInt32* m_signatures;
+      bool* m_reused;
+      CacheSetInfoSHiP* m_set_info;
+};
+
+#endif /* CACHE_SET_SHIP_H */
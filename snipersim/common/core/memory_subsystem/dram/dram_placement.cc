@@ -0,0 +1,232 @@
+#include "dram_placement.h"
+#include "simulator.h"
+#include "config.h"
+#include "config.hpp"
+#include "stats.h"
+#include "log.h"
+#include "utils.h"
+
+#include <algorithm>
+
+DramPlacement* DramPlacement::s_instance = NULL;
+UInt32 DramPlacement::s_num_users = 0;
+
+DramPlacement* DramPlacement::acquire(const std::vector<core_id_t>& core_list)
+{
+   String policy = Sim()->getCfg()->getString("perf_model/dram/placement/policy");
+   if (policy == "line")
+      return NULL;
+
+   // Memory managers are created sequentially during CoreManager construction
+   if (s_num_users++ == 0)
+   {
+      if (policy == "interleave")
+         s_instance = new DramPlacement(INTERLEAVE, core_list);
+      else if (policy == "node_bind")
+         s_instance = new DramPlacement(NODE_BIND, core_list);
+      else if (policy == "first_touch")
+         s_instance = new DramPlacement(FIRST_TOUCH, core_list);
+      else if (policy == "hot_page")
+      {
+         // The fault injection data of a line lives in the DRAM controller it was written to, and is not moved with the page
+         LOG_ASSERT_ERROR(!Sim()->getFaultinjectionManager(), "perf_model/dram/placement/policy hot_page cannot be combined with fault injection");
+         s_instance = new DramPlacement(HOT_PAGE, core_list);
+      }
+      else
+         LOG_PRINT_ERROR("Invalid perf_model/dram/placement/policy %s", policy.c_str());
+   }
+   return s_instance;
+}
+
+void DramPlacement::release(DramPlacement *placement)
+{
+   if (placement == NULL)
+      return;
+
+   if (--s_num_users == 0)
+   {
+      delete s_instance;
+      s_instance = NULL;
+   }
+}
+
+DramPlacement::DramPlacement(policy_t policy, const std::vector<core_id_t>& core_list)
+   : m_policy(policy)
+   , m_num_modules(core_list.size())
+   , m_mask(0)
+   , m_num_pages(0)
+   , m_migration_epoch(Sim()->getCfg()->getInt("perf_model/dram/placement/migration_epoch"))
+   , m_migration_threshold(Sim()->getCfg()->getInt("perf_model/dram/placement/migration_threshold"))
+   , m_num_accesses(0)
+   , m_migrations(0)
+{
+   UInt64 page_size = Sim()->getCfg()->getInt("perf_model/dram/placement/page_size");
+   LOG_ASSERT_ERROR(page_size > 0 && (page_size & (page_size - 1)) == 0, "perf_model/dram/placement/page_size (%lu) must be a power of two", page_size);
+   m_page_bits = floorLog2(page_size);
+   LOG_ASSERT_ERROR(m_migration_epoch > 0, "perf_model/dram/placement/migration_epoch must be positive");
+
+   // Each core is local to the controller with the highest core id not above its own (or the first controller)
+   UInt32 num_cores = Config::getSingleton()->getTotalCores();
+   std::vector<std::pair<core_id_t, UInt32> > modules;
+   for (UInt32 module = 0; module < m_num_modules; ++module)
+      modules.push_back(std::make_pair(core_list[module], module));
+   std::sort(modules.begin(), modules.end());
+   m_core_module.resize(num_cores);
+   UInt32 next = 0;
+   for (core_id_t core = 0; core < (core_id_t)num_cores; ++core)
+   {
+      while (next + 1 < modules.size() && modules[next + 1].first <= core)
+         ++next;
+      m_core_module[core] = modules[next].second;
+   }
+
+   if (m_policy == NODE_BIND)
+   {
+      String bind_controllers = Sim()->getCfg()->getString("perf_model/dram/placement/bind_controllers");
+      size_t start = 0;
+      while (start < bind_controllers.size())
+      {
+         size_t end = bind_controllers.find(',', start);
+         if (end == String::npos)
+            end = bind_controllers.size();
+         UInt32 module = atoi(bind_controllers.substr(start, end - start).c_str());
+         LOG_ASSERT_ERROR(module < m_num_modules, "perf_model/dram/placement/bind_controllers: controller %u does not exist (%u controllers)", module, m_num_modules);
+         m_bind_modules.push_back(module);
+         start = end + 1;
+      }
+      LOG_ASSERT_ERROR(!m_bind_modules.empty(), "perf_model/dram/placement/policy = node_bind needs perf_model/dram/placement/bind_controllers");
+   }
+
+   if (m_policy == FIRST_TOUCH || m_policy == HOT_PAGE)
+   {
+      m_slots.resize(1024);
+      m_mask = m_slots.size() - 1;
+   }
+
+   m_local_accesses.resize(num_cores, 0);
+   m_remote_accesses.resize(num_cores, 0);
+   for (core_id_t core = 0; core < (core_id_t)num_cores; ++core)
+   {
+      registerStatsMetric("dram-placement", core, "local-accesses", &m_local_accesses[core]);
+      registerStatsMetric("dram-placement", core, "remote-accesses", &m_remote_accesses[core]);
+   }
+   registerStatsMetric("dram-placement", 0, "pages", &m_num_pages);
+   registerStatsMetric("dram-placement", 0, "migrations", &m_migrations);
+}
+
+UInt32 DramPlacement::getModule(IntPtr address, core_id_t requester)
+{
+   UInt64 page = address >> m_page_bits;
+   bool known_requester = requester >= 0 && requester < (core_id_t)m_core_module.size();
+   UInt32 module = 0;
+
+   switch (m_policy)
+   {
+      case INTERLEAVE:
+         module = page % m_num_modules;
+         break;
+      case NODE_BIND:
+         module = m_bind_modules[page % m_bind_modules.size()];
+         break;
+      case FIRST_TOUCH:
+      case HOT_PAGE:
+      {
+         // Only the page table is shared state, the other policies are pure functions of the page
+         ScopedLock sl(m_lock);
+         bool inserted;
+         slot_t &slot = lookup(page, inserted);
+         if (inserted)
+            slot.module = known_requester ? m_core_module[requester] : page % m_num_modules;
+         if (m_policy == HOT_PAGE && known_requester)
+         {
+            m_num_accesses ++;
+            vote(slot, m_core_module[requester]);
+         }
+         module = slot.module;
+         break;
+      }
+      default:
+         LOG_PRINT_ERROR("Invalid DRAM placement policy %d", m_policy);
+   }
+
+   if (known_requester)
+   {
+      if (module == m_core_module[requester])
+         m_local_accesses[requester] ++;
+      else
+         m_remote_accesses[requester] ++;
+   }
+
+   return module;
+}
+
+DramPlacement::slot_t& DramPlacement::lookup(UInt64 page, bool& inserted)
+{
+   UInt64 key = page + 1;
+   UInt64 hash = key * 0x9E3779B97F4A7C15ull;
+   for (UInt64 i = (hash ^ (hash >> 32)) & m_mask;; i = (i + 1) & m_mask)
+   {
+      slot_t &slot = m_slots[i];
+      if (slot.key == key)
+      {
+         inserted = false;
+         return slot;
+      }
+      if (slot.key == 0)
+      {
+         if ((m_num_pages + 1) * 2 > m_slots.size())
+         {
+            grow();
+            return lookup(page, inserted);
+         }
+         slot.key = key;
+         slot.votes = 0;
+         slot.vote_epoch = 0;
+         m_num_pages ++;
+         inserted = true;
+         return slot;
+      }
+   }
+}
+
+void DramPlacement::grow()
+{
+   std::vector<slot_t> slots(m_slots.size() * 2);
+   std::swap(slots, m_slots);
+   m_mask = m_slots.size() - 1;
+   for (std::vector<slot_t>::iterator it = slots.begin(); it != slots.end(); ++it)
+   {
+      if (it->key == 0)
+         continue;
+      UInt64 hash = it->key * 0x9E3779B97F4A7C15ull;
+      UInt64 i = (hash ^ (hash >> 32)) & m_mask;
+      while (m_slots[i].key != 0)
+         i = (i + 1) & m_mask;
+      m_slots[i] = *it;
+   }
+}
+
+// Boyer-Moore majority vote over the controllers local to the requesters of the page in the current epoch
+void DramPlacement::vote(slot_t& slot, UInt32 module)
+{
+   UInt64 epoch = m_num_accesses / m_migration_epoch;
+   if (slot.vote_epoch != epoch)
+   {
+      slot.vote_epoch = epoch;
+      slot.votes = 0;
+   }
+
+   if (slot.votes == 0)
+      slot.vote_module = module;
+   if (slot.vote_module == module)
+      slot.votes ++;
+   else
+      slot.votes --;
+
+   if (slot.vote_module != slot.module && slot.votes >= m_migration_threshold)
+   {
+      slot.module = slot.vote_module;
+      slot.votes = 0;
+      m_migrations ++;
+   }
+}
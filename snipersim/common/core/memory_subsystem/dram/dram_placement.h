@@ -0,0 +1,86 @@
+#ifndef __DRAM_PLACEMENT_H
+#define __DRAM_PLACEMENT_H
+
+#include "fixed_types.h"
+#include "lock.h"
+
+#include <vector>
+
+// Page-granular placement of memory on the DRAM controllers (perf_model/dram/placement)
+//
+// Used by the DRAM controller AddressHomeLookup of every core in place of block interleaving. All cores share
+// one instance so that they agree on where each page lives. Controller i is local to the cores from its own
+// core id up to the next controller's.
+//
+// Policies:
+// - interleave:  page i goes to controller i % #controllers
+// - node_bind:   pages are interleaved over the controllers in bind_controllers
+// - first_touch: a page goes to the controller local to the first core that accesses it
+// - hot_page:    first_touch, and a page moves to another controller once the cores local to it have made
+//                migration_threshold more accesses to the page than all other cores together within a
+//                migration_epoch (a majority vote per page). Only the mapping changes, the move is not timed.
+//                Not supported with fault injection, whose per-controller line data would not follow the page.
+//
+// first_touch and hot_page keep a page -> controller table (open addressing, one 24-byte slot per touched page);
+// the other policies are computed from the page number.
+
+class DramPlacement
+{
+   public:
+      // Returns the placement shared by all cores, or NULL if the policy is "line" (block interleaving)
+      static DramPlacement* acquire(const std::vector<core_id_t>& core_list);
+      static void release(DramPlacement *placement);
+
+      // Returns the index of the controller in the core list that holds the address. requester may be
+      // INVALID_CORE_ID if it is unknown, in which case the access is not counted as local or remote.
+      UInt32 getModule(IntPtr address, core_id_t requester);
+
+   private:
+      enum policy_t
+      {
+         INTERLEAVE,
+         NODE_BIND,
+         FIRST_TOUCH,
+         HOT_PAGE,
+      };
+
+      struct slot_t
+      {
+         UInt64 key;          // page + 1, 0 if the slot is empty
+         UInt16 module;
+         UInt16 vote_module;  // Majority candidate of the current vote
+         UInt32 votes;
+         UInt64 vote_epoch;   // The vote is stale if it is from an earlier epoch
+      };
+
+      static DramPlacement *s_instance;
+      static UInt32 s_num_users;
+
+      Lock m_lock;                           // Protects the page table of first_touch and hot_page
+
+      policy_t m_policy;
+      UInt32 m_page_bits;
+      UInt32 m_num_modules;
+      std::vector<UInt32> m_core_module;     // Local controller of each core
+      std::vector<UInt32> m_bind_modules;
+
+      std::vector<slot_t> m_slots;
+      UInt64 m_mask;
+      UInt64 m_num_pages;
+
+      UInt64 m_migration_epoch;
+      UInt32 m_migration_threshold;
+      UInt64 m_num_accesses;
+
+      std::vector<UInt64> m_local_accesses;  // Per core
+      std::vector<UInt64> m_remote_accesses;
+      UInt64 m_migrations;
+
+      DramPlacement(policy_t policy, const std::vector<core_id_t>& core_list);
+
+      slot_t& lookup(UInt64 page, bool& inserted);
+      void grow();
+      void vote(slot_t& slot, UInt32 module);
+};
+
+#endif // __DRAM_PLACEMENT_H
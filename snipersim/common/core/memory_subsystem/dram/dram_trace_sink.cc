@@ -0,0 +1,334 @@
+#include "dram_trace_sink.h"
+#include "simulator.h"
+#include "config.hpp"
+#include "log.h"
+
+#include <zlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <queue>
+
+DramTraceSink* DramTraceSink::g_singleton = NULL;
+
+void DramTraceSink::init()
+{
+   if (Sim()->getCfg()->getBoolDefault("perf_model/dram/trace/enabled", false))
+      g_singleton = new DramTraceSink();
+}
+
+void DramTraceSink::fini()
+{
+   if (g_singleton)
+   {
+      delete g_singleton;
+      g_singleton = NULL;
+   }
+}
+
+DramTraceSink::Buffer* DramTraceSink::registerController(core_id_t controller)
+{
+   if (!g_singleton)
+      return NULL;
+
+   ScopedLock sl(g_singleton->m_lock);
+   Buffer *buffer = new Buffer(g_singleton, controller, g_singleton->m_buffer_size);
+   g_singleton->m_buffers.push_back(buffer);
+   return buffer;
+}
+
+DramTraceSink::Buffer::Buffer(DramTraceSink *sink, core_id_t controller, UInt32 size)
+   : m_sink(sink)
+   , m_controller(controller)
+   , m_mask(size - 1)
+   , m_slots(new slot_t[size])
+   , m_head(0)
+   , m_tail(0)
+{
+   LOG_ASSERT_ERROR((size & (size - 1)) == 0, "perf_model/dram/trace/buffer_size must be a power of two");
+   for(UInt64 i = 0; i < size; ++i)
+      m_slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+DramTraceSink::Buffer::~Buffer()
+{
+   delete [] m_slots;
+}
+
+bool DramTraceSink::Buffer::push(const record_t &rec)
+{
+   UInt64 pos = m_head.load(std::memory_order_relaxed);
+   while (true)
+   {
+      slot_t &slot = m_slots[pos & m_mask];
+      UInt64 seq = slot.sequence.load(std::memory_order_acquire);
+      SInt64 diff = (SInt64)seq - (SInt64)pos;
+      if (diff == 0)
+      {
+         if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+         {
+            slot.record = rec;
+            slot.sequence.store(pos + 1, std::memory_order_release);
+            return true;
+         }
+      }
+      else if (diff < 0)
+      {
+         // Full
+         return false;
+      }
+      else
+      {
+         pos = m_head.load(std::memory_order_relaxed);
+      }
+   }
+}
+
+bool DramTraceSink::Buffer::pop(record_t &rec)
+{
+   slot_t &slot = m_slots[m_tail & m_mask];
+   UInt64 seq = slot.sequence.load(std::memory_order_acquire);
+   if (seq != m_tail + 1)
+      // Empty, or the producer that claimed this slot has not finished writing it yet
+      return false;
+
+   rec = slot.record;
+   slot.sequence.store(m_tail + m_mask + 1, std::memory_order_release);
+   ++m_tail;
+   return true;
+}
+
+DramTraceSink::DramTraceSink()
+   : m_filename(Sim()->getCfg()->getString("perf_model/dram/trace/filename"))
+   , m_binary(Sim()->getCfg()->getString("perf_model/dram/trace/format") == "binary")
+   , m_compress(Sim()->getCfg()->getBool("perf_model/dram/trace/compress"))
+   , m_buffer_size(Sim()->getCfg()->getInt("perf_model/dram/trace/buffer_size"))
+   , m_chunk_size(Sim()->getCfg()->getInt("perf_model/dram/trace/chunk_size"))
+   , m_num_runs(0)
+   , m_num_records(0)
+   , m_thread_done(0)
+   , m_running(true)
+{
+   String format = Sim()->getCfg()->getString("perf_model/dram/trace/format");
+   LOG_ASSERT_ERROR(format == "text" || format == "binary", "Invalid perf_model/dram/trace/format %s, expected text or binary", format.c_str());
+   // Ramulator2's CustomTrace2Binary memory-maps the trace, which does not work on a gzip file
+   LOG_ASSERT_ERROR(!(m_binary && m_compress), "perf_model/dram/trace/format = binary cannot be combined with perf_model/dram/trace/compress = true");
+
+   m_chunk.reserve(m_chunk_size);
+
+   m_thread = _Thread::create(this);
+   m_thread->run();
+}
+
+DramTraceSink::~DramTraceSink()
+{
+   m_running = false;
+   m_wakeup.signal();
+   m_thread_done.wait();
+   delete m_thread;
+
+   // Simulation threads are gone by now, pick up anything that was appended after the writer thread's last pass
+   {
+      ScopedLock sl(m_lock);
+      drainAll();
+      queueChunk();
+   }
+   spillQueued();
+   merge();
+
+   for(std::vector<Buffer*>::iterator it = m_buffers.begin(); it != m_buffers.end(); ++it)
+      delete *it;
+}
+
+void DramTraceSink::run()
+{
+   m_lock.acquire();
+   while (m_running)
+   {
+      drainAll();
+      if (!m_full_chunks.empty())
+      {
+         // Spill without the lock, so that producers with a full buffer can keep draining into a new chunk
+         m_lock.release();
+         spillQueued();
+         m_lock.acquire();
+         continue;
+      }
+      m_wakeup.wait(m_lock, 1000000);
+   }
+   m_lock.release();
+   m_thread_done.signal();
+}
+
+// Slow path for a producer that found its buffer full: empty it into the chunk ourselves (full chunks are left to the writer thread)
+void DramTraceSink::drain(Buffer *buffer)
+{
+   ScopedLock sl(m_lock);
+   drainBuffer(buffer);
+}
+
+// Called with m_lock held
+void DramTraceSink::drainBuffer(Buffer *buffer)
+{
+   record_t rec;
+   while (buffer->pop(rec))
+   {
+      m_chunk.push_back(rec);
+      if (m_chunk.size() >= m_chunk_size)
+         queueChunk();
+   }
+}
+
+// Called with m_lock held
+void DramTraceSink::queueChunk()
+{
+   if (m_chunk.empty())
+      return;
+
+   m_full_chunks.push_back(std::vector<record_t>());
+   m_full_chunks.back().swap(m_chunk);
+   m_chunk.reserve(m_chunk_size);
+   m_wakeup.signal();
+}
+
+// Called by the writer thread without m_lock held (or from the destructor once it is gone)
+void DramTraceSink::spillQueued()
+{
+   while (true)
+   {
+      std::vector<record_t> chunk;
+      {
+         ScopedLock sl(m_lock);
+         if (m_full_chunks.empty())
+            return;
+         chunk.swap(m_full_chunks.front());
+         m_full_chunks.erase(m_full_chunks.begin());
+      }
+      spill(chunk);
+   }
+}
+
+// Called with m_lock held
+void DramTraceSink::drainAll()
+{
+   for(std::vector<Buffer*>::iterator it = m_buffers.begin(); it != m_buffers.end(); ++it)
+      drainBuffer(*it);
+}
+
+String DramTraceSink::getRunName(UInt32 run_id) const
+{
+   return Sim()->getConfig()->formatOutputFileName(m_filename + ".run" + itostr(run_id));
+}
+
+static void writeTrace(gzFile fp, const void *data, size_t size, const String &filename)
+{
+   LOG_ASSERT_ERROR(gzwrite(fp, data, size) == (int)size, "Cannot write DRAM trace %s (disk full?)", filename.c_str());
+}
+
+static void closeTrace(gzFile fp, const String &filename)
+{
+   LOG_ASSERT_ERROR(gzclose(fp) == Z_OK, "Cannot write DRAM trace %s (disk full?)", filename.c_str());
+}
+
+void DramTraceSink::spill(std::vector<record_t> &chunk)
+{
+   std::stable_sort(chunk.begin(), chunk.end(), [](const record_t &a, const record_t &b) { return a.time_ns < b.time_ns; });
+
+   String filename = getRunName(m_num_runs++);
+   gzFile fp = gzopen(filename.c_str(), m_compress ? "wb1" : "wbT");
+   LOG_ASSERT_ERROR(fp != NULL, "Cannot open DRAM trace run %s", filename.c_str());
+   writeTrace(fp, chunk.data(), chunk.size() * sizeof(record_t), filename);
+   closeTrace(fp, filename);
+
+   m_num_records += chunk.size();
+}
+
+void DramTraceSink::merge()
+{
+   class RunReader
+   {
+      private:
+         gzFile m_fp;
+         std::vector<record_t> m_buffer;
+         size_t m_pos, m_size;
+      public:
+         RunReader(String filename)
+            : m_fp(gzopen(filename.c_str(), "rb"))
+            , m_buffer(16384)
+            , m_pos(0)
+            , m_size(0)
+         {
+            LOG_ASSERT_ERROR(m_fp != NULL, "Cannot open DRAM trace run %s", filename.c_str());
+         }
+         ~RunReader() { gzclose(m_fp); }
+         bool next(record_t &rec)
+         {
+            if (m_pos == m_size)
+            {
+               int bytes = gzread(m_fp, m_buffer.data(), m_buffer.size() * sizeof(record_t));
+               m_size = bytes > 0 ? bytes / sizeof(record_t) : 0;
+               m_pos = 0;
+               if (m_size == 0)
+                  return false;
+            }
+            rec = m_buffer[m_pos++];
+            return true;
+         }
+   };
+
+   String filename = Sim()->getConfig()->formatOutputFileName(m_filename + (m_compress ? ".gz" : ""));
+   gzFile out = gzopen(filename.c_str(), m_compress ? "wb1" : "wbT");
+   LOG_ASSERT_ERROR(out != NULL, "Cannot open DRAM trace %s", filename.c_str());
+   gzbuffer(out, 1 << 20);
+
+   if (m_binary)
+   {
+      // Same layout as Ramulator2's BinaryTraceHeader
+      struct { char magic[8]; UInt32 version; UInt32 record_size; UInt64 num_records; } header =
+         { { 'R', 'A', 'M', 'T', 'R', 'C', '2', '\0' }, 1, sizeof(record_t), m_num_records };
+      writeTrace(out, &header, sizeof(header), filename);
+   }
+
+   std::vector<RunReader*> runs;
+   typedef std::pair<record_t, UInt32> entry_t;
+   auto later = [](const entry_t &a, const entry_t &b)
+   {
+      return a.first.time_ns != b.first.time_ns ? a.first.time_ns > b.first.time_ns : a.second > b.second;
+   };
+   std::priority_queue<entry_t, std::vector<entry_t>, decltype(later)> heap(later);
+
+   for(UInt32 run_id = 0; run_id < m_num_runs; ++run_id)
+   {
+      runs.push_back(new RunReader(getRunName(run_id)));
+      record_t rec;
+      if (runs.back()->next(rec))
+         heap.push(entry_t(rec, run_id));
+   }
+
+   while (!heap.empty())
+   {
+      entry_t top = heap.top();
+      heap.pop();
+
+      if (m_binary)
+         writeTrace(out, &top.first, sizeof(record_t), filename);
+      else
+      {
+         char line[64];
+         int length = snprintf(line, sizeof(line), "%" PRIu64 " %c %" PRIu64 " %d\n", top.first.time_ns, top.first.type ? 'W' : 'R', top.first.address, top.first.requester);
+         writeTrace(out, line, length, filename);
+      }
+
+      record_t rec;
+      if (runs[top.second]->next(rec))
+         heap.push(entry_t(rec, top.second));
+   }
+   closeTrace(out, filename);
+
+   for(UInt32 run_id = 0; run_id < m_num_runs; ++run_id)
+   {
+      delete runs[run_id];
+      unlink(getRunName(run_id).c_str());
+   }
+
+   LOG_PRINT("Wrote %" PRIu64 " DRAM accesses to %s", m_num_records, filename.c_str());
+}
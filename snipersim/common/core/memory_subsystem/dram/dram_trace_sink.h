@@ -0,0 +1,111 @@
+#ifndef __DRAM_TRACE_SINK_H
+#define __DRAM_TRACE_SINK_H
+
+#include "fixed_types.h"
+#include "lock.h"
+#include "cond.h"
+#include "sem.h"
+#include "_thread.h"
+
+#include <atomic>
+#include <vector>
+
+// Collects the DRAM access trace of all DRAM controllers (perf_model/dram/trace)
+//
+// Each controller owns a bounded lock-free ring buffer that any simulation thread can append to
+// without taking a lock or doing I/O. A background writer thread drains all rings into an in-memory
+// chunk, which is sorted by timestamp and spilled to disk as a (optionally gzip-compressed) binary run
+// once it is full. A simulation thread that finds its ring full drains it into the chunk itself, but
+// leaves full chunks to the writer thread, so sorting and disk I/O never happen on a simulation thread. At simulation end, all runs are merged by timestamp into the final trace, so the
+// output is already sorted and can be fed to Ramulator2 without a separate sorting step.
+//
+// The text output uses the "<ns> <R|W> <address> <requester>" format read by Ramulator2's CustomTrace2,
+// the binary output uses the record layout of Ramulator2's CustomTrace2Binary frontend.
+
+class DramTraceSink : public Runnable
+{
+   public:
+      // Same layout as Ramulator2's BinaryTraceRecord
+      typedef struct
+      {
+         UInt64 time_ns;
+         UInt64 address;
+         SInt32 requester;
+         UInt32 type;   // 0 = read, 1 = write
+      } record_t;
+
+      class Buffer
+      {
+         public:
+            void record(UInt64 time_ns, IntPtr address, core_id_t requester, bool is_write)
+            {
+               record_t rec = { time_ns, (UInt64)address, (SInt32)requester, is_write ? 1u : 0u };
+               while (!push(rec))
+                  m_sink->drain(this);
+            }
+
+         private:
+            // Vyukov-style bounded queue: producers claim a slot with a CAS on m_head, the consumer
+            // (always called with the sink lock held) frees slots by advancing m_tail
+            struct slot_t
+            {
+               std::atomic<UInt64> sequence;
+               record_t record;
+            };
+
+            DramTraceSink * const m_sink;
+            const core_id_t m_controller;
+            const UInt64 m_mask;
+            slot_t * const m_slots;
+            alignas(64) std::atomic<UInt64> m_head;
+            alignas(64) UInt64 m_tail;
+
+            Buffer(DramTraceSink *sink, core_id_t controller, UInt32 size);
+            ~Buffer();
+
+            bool push(const record_t &rec);
+            bool pop(record_t &rec);
+
+            friend class DramTraceSink;
+      };
+
+      static void init();
+      static void fini();
+      static Buffer* registerController(core_id_t controller);
+
+   private:
+      static DramTraceSink *g_singleton;
+
+      DramTraceSink();
+      ~DramTraceSink();
+
+      void run();
+      void drain(Buffer *buffer);
+      void drainBuffer(Buffer *buffer);
+      void drainAll();
+      void queueChunk();
+      void spillQueued();
+      void spill(std::vector<record_t> &chunk);
+      void merge();
+      String getRunName(UInt32 run_id) const;
+
+      const String m_filename;
+      const bool m_binary;
+      const bool m_compress;
+      const UInt32 m_buffer_size;
+      const UInt64 m_chunk_size;
+
+      Lock m_lock;                        // Protects the consumer side of all buffers, m_chunk and m_full_chunks
+      std::vector<Buffer*> m_buffers;
+      std::vector<record_t> m_chunk;
+      std::vector<std::vector<record_t> > m_full_chunks; // Waiting to be spilled by the writer thread
+      UInt32 m_num_runs;                  // Only touched by the writer thread (and by the destructor once it is gone)
+      UInt64 m_num_records;
+
+      _Thread *m_thread;
+      ConditionVariable m_wakeup;
+      Semaphore m_thread_done;
+      volatile bool m_running;
+};
+
+#endif // __DRAM_TRACE_SINK_H
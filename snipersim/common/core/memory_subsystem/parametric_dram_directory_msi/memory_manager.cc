@@ -3,7 +3,9 @@
 #include "cache_base.h"
 #include "nuca_cache.h"
 #include "dram_cache.h"
+#include "dram_placement.h"
 #include "tlb.h"
+#include "page_walker.h"
 #include "simulator.h"
 #include "log.h"
 #include "dvfs_manager.h"
@@ -40,6 +42,10 @@ MemoryManager::MemoryManager(Core* core,
    m_itlb(NULL), m_dtlb(NULL), m_stlb(NULL),
    m_tlb_miss_penalty(NULL,0),
    m_tlb_miss_parallel(false),
+   m_page_size(TLB::PAGE_4KB),
+   m_huge_page_size(TLB::PAGE_4KB),
+   m_huge_page_threshold(0),
+   m_page_walker(NULL),
    m_tag_directory_present(false),
    m_dram_cntlr_present(false),
    m_enabled(false)
@@ -80,6 +86,14 @@ MemoryManager::MemoryManager(Core* core,
          m_dtlb = new TLB("dtlb", "perf_model/dtlb", getCore()->getId(), dtlb_size, Sim()->getCfg()->getInt("perf_model/dtlb/associativity"), m_stlb);
       m_tlb_miss_penalty = ComponentLatency(core->getDvfsDomain(), Sim()->getCfg()->getInt("perf_model/tlb/penalty"));
       m_tlb_miss_parallel = Sim()->getCfg()->getBool("perf_model/tlb/penalty_parallel");
+      m_page_size = TLB::parsePageSize(Sim()->getCfg()->getInt("perf_model/tlb/page_size"));
+      m_huge_page_size = TLB::parsePageSize(Sim()->getCfg()->getInt("perf_model/tlb/huge_page_size"));
+      float huge_page_coverage = Sim()->getCfg()->getFloat("perf_model/tlb/huge_page_coverage");
+      LOG_ASSERT_ERROR(huge_page_coverage >= 0 && huge_page_coverage <= 1, "perf_model/tlb/huge_page_coverage must be between 0 and 1");
+      LOG_ASSERT_ERROR(huge_page_coverage == 0 || m_huge_page_size > m_page_size, "perf_model/tlb/huge_page_size must be larger than perf_model/tlb/page_size");
+      m_huge_page_threshold = UInt32(huge_page_coverage * 65536);
+      if (Sim()->getCfg()->getBool("perf_model/tlb/page_walk"))
+         m_page_walker = new PageWalker("page-walker", "perf_model/tlb", getCore()->getId(), Sim()->getCfg()->getInt("perf_model/tlb/page_table_base"));
 
       smt_cores = Sim()->getCfg()->getInt("perf_model/core/logical_cpus");
 
@@ -220,7 +234,7 @@ MemoryManager::MemoryManager(Core* core,
    }
 
    m_tag_directory_home_lookup = new AddressHomeLookup(dram_directory_home_lookup_param, core_list_with_tag_directories, getCacheBlockSize());
-   m_dram_controller_home_lookup = new AddressHomeLookup(dram_directory_home_lookup_param, core_list_with_dram_controllers, getCacheBlockSize());
+   m_dram_controller_home_lookup = new AddressHomeLookup(dram_directory_home_lookup_param, core_list_with_dram_controllers, getCacheBlockSize(), DramPlacement::acquire(core_list_with_dram_controllers));
 
    // if (m_core->getId() == 0)
    //   printCoreListWithMemoryControllers(core_list_with_dram_controllers);
@@ -386,6 +400,7 @@ MemoryManager::~MemoryManager()
    if (m_itlb) delete m_itlb;
    if (m_dtlb) delete m_dtlb;
    if (m_stlb) delete m_stlb;
+   if (m_page_walker) delete m_page_walker;
 
    for(i = MemComponent::FIRST_LEVEL_CACHE; i <= (UInt32)m_last_level_cache; ++i)
    {
@@ -589,24 +604,68 @@ MYLOG("bcast msg");
 void
 MemoryManager::accessTLB(TLB * tlb, IntPtr address, bool isIfetch, Core::MemModeled modeled)
 {
-   bool hit = tlb->lookup(address, getShmemPerfModel()->getElapsedTime(ShmemPerfModel::_USER_THREAD));
+   TLB::page_size_t page_size = getPageSize(address);
+   bool hit = tlb->lookup(address, page_size, getShmemPerfModel()->getElapsedTime(ShmemPerfModel::_USER_THREAD));
    if (hit == false
        && !(modeled == Core::MEM_MODELED_NONE || modeled == Core::MEM_MODELED_COUNT)
-       && m_tlb_miss_penalty.getLatency() != SubsecondTime::Zero()
    )
    {
+      SubsecondTime latency = m_tlb_miss_penalty.getLatency();
+      if (m_page_walker)
+         latency += walkPageTable(address, page_size);
+
+      if (latency == SubsecondTime::Zero())
+         return;
+
       if (m_tlb_miss_parallel)
       {
-         incrElapsedTime(m_tlb_miss_penalty.getLatency(), ShmemPerfModel::_USER_THREAD);
+         incrElapsedTime(latency, ShmemPerfModel::_USER_THREAD);
       }
       else
       {
-         PseudoInstruction *i = new TLBMissInstruction(m_tlb_miss_penalty.getLatency(), isIfetch);
+         PseudoInstruction *i = new TLBMissInstruction(latency, isIfetch);
          getCore()->getPerformanceModel()->queuePseudoInstruction(i);
       }
    }
 }
 
+TLB::page_size_t
+MemoryManager::getPageSize(IntPtr address) const
+{
+   if (m_huge_page_threshold == 0)
+      return m_page_size;
+
+   // Pick the huge page regions that are backed by a huge page (as THP would) with a fixed hash of the region,
+   // so that all cores agree and runs are repeatable
+   UInt64 hash = (address >> TLB::getPageShift(m_huge_page_size)) * 0x9E3779B97F4A7C15ull;
+   return ((hash >> 48) & 0xffff) < m_huge_page_threshold ? m_huge_page_size : m_page_size;
+}
+
+// Reads the page table entries of a TLB miss through the L1-D and the rest of the cache hierarchy,
+// and returns how long that took. The caller accounts for the latency.
+SubsecondTime
+MemoryManager::walkPageTable(IntPtr address, TLB::page_size_t page_size)
+{
+   SubsecondTime start = getShmemPerfModel()->getElapsedTime(ShmemPerfModel::_USER_THREAD);
+
+   m_page_walker->walk(address, page_size, start, m_walk_entries);
+   for (std::vector<IntPtr>::iterator it = m_walk_entries.begin(); it != m_walk_entries.end(); ++it)
+   {
+      IntPtr block_address = *it & ~IntPtr(m_cache_block_size - 1);
+      m_cache_cntlrs[MemComponent::L1_DCACHE]->processMemOpFromCore(
+            Core::NONE,
+            Core::READ,
+            block_address, *it - block_address,
+            NULL, sizeof(UInt64),
+            true, true);
+   }
+
+   SubsecondTime latency = getShmemPerfModel()->getElapsedTime(ShmemPerfModel::_USER_THREAD) - start;
+   getShmemPerfModel()->setElapsedTime(ShmemPerfModel::_USER_THREAD, start);
+   m_page_walker->walkDone(latency);
+   return latency;
+}
+
 SubsecondTime
 MemoryManager::getCost(MemComponent::component_t mem_component, CachePerfModel::CacheAccess_t access_type)
 {
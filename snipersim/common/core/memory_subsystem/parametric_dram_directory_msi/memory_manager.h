@@ -13,15 +13,17 @@
 #include "shmem_perf_model.h"
 #include "shared_cache_block_info.h"
 #include "subsecond_time.h"
+#include "tlb.h"
 
 #include <map>
+#include <vector>
 
 class DramCache;
 class ShmemPerf;
 
 namespace ParametricDramDirectoryMSI
 {
-   class TLB;
+   class PageWalker;
 
    typedef std::pair<core_id_t, MemComponent::component_t> CoreComponentType;
    typedef std::map<CoreComponentType, CacheCntlr*> CacheCntlrMap;
@@ -39,6 +41,10 @@ namespace ParametricDramDirectoryMSI
          TLB *m_itlb, *m_dtlb, *m_stlb;
          ComponentLatency m_tlb_miss_penalty;
          bool m_tlb_miss_parallel;
+         TLB::page_size_t m_page_size, m_huge_page_size;
+         UInt32 m_huge_page_threshold;    // Fraction of the huge page regions that use huge pages, out of 65536
+         PageWalker *m_page_walker;       // NULL if TLB misses only cost perf_model/tlb/penalty
+         std::vector<IntPtr> m_walk_entries;
 
          core_id_t m_core_id_master;
 
@@ -61,6 +67,8 @@ namespace ParametricDramDirectoryMSI
          static CacheCntlrMap m_all_cache_cntlrs;
 
          void accessTLB(TLB * tlb, IntPtr address, bool isIfetch, Core::MemModeled modeled);
+         TLB::page_size_t getPageSize(IntPtr address) const;
+         SubsecondTime walkPageTable(IntPtr address, TLB::page_size_t page_size);
 
       public:
          MemoryManager(Core* core, Network* network, ShmemPerfModel* shmem_perf_model);
@@ -0,0 +1,85 @@
+#include "page_walker.h"
+#include "stats.h"
+#include "config.hpp"
+#include "simulator.h"
+
+namespace ParametricDramDirectoryMSI
+{
+
+PageWalker::PageWalker(String name, String cfgname, core_id_t core_id, IntPtr page_table_base)
+   : m_page_table_base(page_table_base)
+   , m_pwc(NULL)
+   , m_walks(0)
+   , m_pwc_hits(0)
+   , m_memory_accesses(0)
+   , m_total_latency(SubsecondTime::Zero())
+{
+   UInt32 pwc_size = Sim()->getCfg()->getInt(cfgname + "/page_walk_cache/size");
+   UInt32 pwc_associativity = Sim()->getCfg()->getInt(cfgname + "/page_walk_cache/associativity");
+   if (pwc_size)
+   {
+      LOG_ASSERT_ERROR((pwc_size / pwc_associativity) * pwc_associativity == pwc_size, "Invalid page walk cache configuration: size(%d) must be a multiple of the associativity(%d)", pwc_size, pwc_associativity);
+      m_pwc = new Cache(name + "_pwc", cfgname + "/page_walk_cache", core_id, pwc_size / pwc_associativity, pwc_associativity, ENTRY_SIZE, "lru", CacheBase::PR_L1_CACHE);
+   }
+
+   registerStatsMetric(name, core_id, "walks", &m_walks);
+   registerStatsMetric(name, core_id, "pwc-hits", &m_pwc_hits);
+   registerStatsMetric(name, core_id, "memory-accesses", &m_memory_accesses);
+   registerStatsMetric(name, core_id, "total-latency", &m_total_latency);
+}
+
+PageWalker::~PageWalker()
+{
+   if (m_pwc)
+      delete m_pwc;
+}
+
+IntPtr
+PageWalker::getEntryAddress(IntPtr address, UInt32 level) const
+{
+   // Each level gets its own 1TB region, the entry index is the part of the (48-bit) virtual address above the level
+   address &= (IntPtr(1) << 48) - 1;
+   return m_page_table_base + (IntPtr(level - 1) << 40) + (address >> TLB::getPageShift(TLB::page_size_t(level - 1))) * ENTRY_SIZE;
+}
+
+void
+PageWalker::walk(IntPtr address, TLB::page_size_t page_size, SubsecondTime now, std::vector<IntPtr>& entries)
+{
+   UInt32 leaf_level = 1 + page_size;
+   UInt32 level = NUM_LEVELS;
+
+   m_walks++;
+
+   // Skip the levels above the lowest non-leaf entry found in the page walk cache
+   if (m_pwc)
+   {
+      for (UInt32 l = leaf_level + 1; l <= NUM_LEVELS; ++l)
+      {
+         if (m_pwc->accessSingleLine(getEntryAddress(address, l), Cache::LOAD, NULL, 0, now, true))
+         {
+            level = l - 1;
+            m_pwc_hits++;
+            break;
+         }
+      }
+   }
+
+   entries.clear();
+   for (; level >= leaf_level; --level)
+   {
+      IntPtr entry = getEntryAddress(address, level);
+      entries.push_back(entry);
+
+      if (m_pwc && level > leaf_level)
+      {
+         bool eviction;
+         IntPtr evict_addr;
+         CacheBlockInfo evict_block_info;
+         m_pwc->insertSingleLine(entry, NULL, &eviction, &evict_addr, &evict_block_info, NULL, now);
+      }
+   }
+
+   m_memory_accesses += entries.size();
+}
+
+}
@@ -0,0 +1,45 @@
+#ifndef PAGE_WALKER_H
+#define PAGE_WALKER_H
+
+#include "fixed_types.h"
+#include "cache.h"
+#include "tlb.h"
+
+#include <vector>
+
+namespace ParametricDramDirectoryMSI
+{
+   // Hardware page walker for a four-level, x86-64 style radix page table (perf_model/tlb/page_walk)
+   //
+   // Sniper does not see the application's page tables, so the tables are synthetic: the entries of each level are
+   // laid out as one linear array starting at page_table_base, which gives neighbouring pages neighbouring entries
+   // (and shared cache lines) as in a real table. A 4KB page is mapped by a level 1 entry, a 2MB page by a level 2
+   // and a 1GB page by a level 3 entry.
+   //
+   // The page walk cache holds the non-leaf entries of recent walks. A walk starts below the lowest level that
+   // hits in it, and the walker returns the entries that still need to be read through the cache hierarchy.
+   class PageWalker
+   {
+      private:
+         static const UInt32 NUM_LEVELS = 4;
+         static const UInt32 ENTRY_SIZE = 8;
+
+         IntPtr m_page_table_base;
+         Cache *m_pwc;
+
+         UInt64 m_walks, m_pwc_hits, m_memory_accesses;
+         SubsecondTime m_total_latency;
+
+         IntPtr getEntryAddress(IntPtr address, UInt32 level) const;
+
+      public:
+         PageWalker(String name, String cfgname, core_id_t core_id, IntPtr page_table_base);
+         ~PageWalker();
+
+         // Returns the addresses of the page table entries to read to translate address, from the root down
+         void walk(IntPtr address, TLB::page_size_t page_size, SubsecondTime now, std::vector<IntPtr>& entries);
+         void walkDone(SubsecondTime latency) { m_total_latency += latency; }
+   };
+}
+
+#endif // PAGE_WALKER_H
@@ -1,9 +1,22 @@
 #include "tlb.h"
 #include "stats.h"
+#include "config.hpp"
+#include "simulator.h"
 
 namespace ParametricDramDirectoryMSI
 {
 
+TLB::page_size_t
+TLB::parsePageSize(UInt64 page_size)
+{
+   for (UInt32 i = 0; i < NUM_PAGE_SIZES; ++i)
+   {
+      if (page_size == (UInt64(1) << getPageShift(page_size_t(i))))
+         return page_size_t(i);
+   }
+   LOG_PRINT_ERROR("Invalid page size %lu, supported are 4KB, 2MB and 1GB", page_size);
+}
+
 TLB::TLB(String name, String cfgname, core_id_t core_id, UInt32 num_entries, UInt32 associativity, TLB *next_level)
    : m_size(num_entries)
    , m_associativity(associativity)
@@ -14,14 +27,46 @@ TLB::TLB(String name, String cfgname, core_id_t core_id, UInt32 num_entries, UIn
 {
    LOG_ASSERT_ERROR((num_entries / associativity) * associativity == num_entries, "Invalid TLB configuration: num_entries(%d) must be a multiple of the associativity(%d)", num_entries, associativity);
 
+   m_huge_caches[PAGE_4KB] = NULL;
+   const char *suffixes[NUM_PAGE_SIZES] = { "", "_2m", "_1g" };
+   for (UInt32 i = PAGE_2MB; i < NUM_PAGE_SIZES; ++i)
+   {
+      UInt32 huge_entries = Sim()->getCfg()->getInt(cfgname + "/size" + suffixes[i]);
+      UInt32 huge_associativity = Sim()->getCfg()->getInt(cfgname + "/associativity" + suffixes[i]);
+      m_huge_caches[i] = NULL;
+      if (huge_entries)
+      {
+         LOG_ASSERT_ERROR((huge_entries / huge_associativity) * huge_associativity == huge_entries, "Invalid TLB configuration: num_entries%s(%d) must be a multiple of the associativity%s(%d)", suffixes[i], huge_entries, suffixes[i], huge_associativity);
+         m_huge_caches[i] = new Cache(name + "_cache" + suffixes[i], cfgname, core_id, huge_entries / huge_associativity, huge_associativity, SIM_PAGE_SIZE, "lru", CacheBase::PR_L1_CACHE);
+      }
+   }
+
    registerStatsMetric(name, core_id, "access", &m_access);
    registerStatsMetric(name, core_id, "miss", &m_miss);
 }
 
+TLB::~TLB()
+{
+   for (UInt32 i = 0; i < NUM_PAGE_SIZES; ++i)
+      delete m_huge_caches[i];
+}
+
+bool
+TLB::lookup(IntPtr address, page_size_t page_size, SubsecondTime now, bool allocate_on_miss)
+{
+   return lookupKey(makeKey(address, page_size), now, allocate_on_miss);
+}
+
+void
+TLB::allocate(IntPtr address, page_size_t page_size, SubsecondTime now)
+{
+   allocateKey(makeKey(address, page_size), now);
+}
+
 bool
-TLB::lookup(IntPtr address, SubsecondTime now, bool allocate_on_miss)
+TLB::lookupKey(IntPtr key, SubsecondTime now, bool allocate_on_miss)
 {
-   bool hit = m_cache.accessSingleLine(address, Cache::LOAD, NULL, 0, now, true);
+   bool hit = getArray(getKeyPageSize(key)).accessSingleLine(key, Cache::LOAD, NULL, 0, now, true);
 
    m_access++;
 
@@ -32,28 +77,28 @@ TLB::lookup(IntPtr address, SubsecondTime now, bool allocate_on_miss)
 
    if (m_next_level)
    {
-      hit = m_next_level->lookup(address, now, false /* no allocation */);
+      hit = m_next_level->lookupKey(key, now, false /* no allocation */);
    }
 
    if (allocate_on_miss)
    {
-      allocate(address, now);
+      allocateKey(key, now);
    }
 
    return hit;
 }
 
 void
-TLB::allocate(IntPtr address, SubsecondTime now)
+TLB::allocateKey(IntPtr key, SubsecondTime now)
 {
    bool eviction;
    IntPtr evict_addr;
    CacheBlockInfo evict_block_info;
-   m_cache.insertSingleLine(address, NULL, &eviction, &evict_addr, &evict_block_info, NULL, now);
+   getArray(getKeyPageSize(key)).insertSingleLine(key, NULL, &eviction, &evict_addr, &evict_block_info, NULL, now);
 
    // Use next level as a victim cache
    if (eviction && m_next_level)
-      m_next_level->allocate(evict_addr, now);
+      m_next_level->allocateKey(evict_addr, now);
 }
 
 }
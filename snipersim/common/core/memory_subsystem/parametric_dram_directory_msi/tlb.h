@@ -8,22 +8,47 @@ namespace ParametricDramDirectoryMSI
 {
    class TLB
    {
+      public:
+         enum page_size_t
+         {
+            PAGE_4KB,
+            PAGE_2MB,
+            PAGE_1GB,
+            NUM_PAGE_SIZES
+         };
+
+         static UInt32 getPageShift(page_size_t page_size) { return 12 + 9 * page_size; }
+         static page_size_t parsePageSize(UInt64 page_size);
+
       private:
          static const UInt32 SIM_PAGE_SHIFT = 12; // 4KB
          static const IntPtr SIM_PAGE_SIZE = (1L << SIM_PAGE_SHIFT);
          static const IntPtr SIM_PAGE_MASK = ~(SIM_PAGE_SIZE - 1);
+         static const UInt32 KEY_SIZE_SHIFT = 62; // The page size is kept in the top bits of the entry keys
 
          UInt32 m_size;
          UInt32 m_associativity;
-         Cache m_cache;
+         Cache m_cache;                            // 4KB entries, and those of page sizes without an array of their own
+         Cache *m_huge_caches[NUM_PAGE_SIZES];     // Per page size array (perf_model/*tlb/size_2m, size_1g), or NULL
 
          TLB *m_next_level;
 
          UInt64 m_access, m_miss;
+
+         // Entries are keyed by their page number (at 4KB granularity in the arrays) and page size
+         static IntPtr makeKey(IntPtr address, page_size_t page_size)
+         { return ((address >> getPageShift(page_size)) << SIM_PAGE_SHIFT) | (IntPtr(page_size) << KEY_SIZE_SHIFT); }
+         static page_size_t getKeyPageSize(IntPtr key) { return page_size_t(key >> KEY_SIZE_SHIFT); }
+
+         Cache& getArray(page_size_t page_size) { return m_huge_caches[page_size] ? *m_huge_caches[page_size] : m_cache; }
+         bool lookupKey(IntPtr key, SubsecondTime now, bool allocate_on_miss);
+         void allocateKey(IntPtr key, SubsecondTime now);
+
       public:
          TLB(String name, String cfgname, core_id_t core_id, UInt32 num_entries, UInt32 associativity, TLB *next_level);
-         bool lookup(IntPtr address, SubsecondTime now, bool allocate_on_miss = true);
-         void allocate(IntPtr address, SubsecondTime now);
+         ~TLB();
+         bool lookup(IntPtr address, page_size_t page_size, SubsecondTime now, bool allocate_on_miss = true);
+         void allocate(IntPtr address, page_size_t page_size, SubsecondTime now);
    };
 }
 
@@ -6,11 +6,7 @@
 #include "stats.h"
 #include "fault_injection.h"
 #include "shmem_perf.h"
-
-#include <fstream>
-
-// File is opened ONCE here, in append mode
-static FILE *fp = fopen("dram_trace.txt", "w");
+#include "dram_trace_sink.h"
 
 #if 0
    extern Lock iolock;
@@ -49,6 +45,8 @@ namespace PrL1PrL2DramDirectoryMSI
                              ? Sim()->getFaultinjectionManager()->getFaultInjector(memory_manager->getCore()->getId(), MemComponent::DRAM)
                              : NULL;
 
+      m_trace = DramTraceSink::registerController(memory_manager->getCore()->getId());
+
       m_dram_access_count = new AccessCountMap[DramCntlrInterface::NUM_ACCESS_TYPES];
       registerStatsMetric("dram", memory_manager->getCore()->getId(), "reads", &m_reads);
       registerStatsMetric("dram", memory_manager->getCore()->getId(), "writes", &m_writes);
@@ -82,14 +80,8 @@ namespace PrL1PrL2DramDirectoryMSI
 
       SubsecondTime dram_access_latency = runDramPerfModel(requester, now, address, READ, perf);
 
-      if (fp)
-      {
-         fprintf(fp, "%lu R %lu %d\n",
-                 now.getNS(),
-                 (uint64_t)address,
-                 requester);
-         fflush(fp);
-      }
+      if (m_trace)
+         m_trace->record(now.getNS(), address, requester, false);
 
       ++m_reads;
 #ifdef ENABLE_DRAM_ACCESS_COUNT
@@ -118,14 +110,8 @@ namespace PrL1PrL2DramDirectoryMSI
 
       SubsecondTime dram_access_latency = runDramPerfModel(requester, now, address, WRITE, &m_dummy_shmem_perf);
 
-      if (fp)
-      {
-         fprintf(fp, "%lu W %lu %d\n",
-                 now.getNS(),
-                 (uint64_t)address,
-                 requester);
-         fflush(fp);
-      }
+      if (m_trace)
+         m_trace->record(now.getNS(), address, requester, true);
 
       ++m_writes;
 #ifdef ENABLE_DRAM_ACCESS_COUNT
@@ -12,6 +12,7 @@
 #include "memory_manager_base.h"
 #include "dram_cntlr_interface.h"
 #include "subsecond_time.h"
+#include "dram_trace_sink.h"
 
 class FaultInjector;
 
@@ -23,6 +24,7 @@ namespace PrL1PrL2DramDirectoryMSI
          std::unordered_map<IntPtr, Byte*> m_data_map;
          DramPerfModel* m_dram_perf_model;
          FaultInjector* m_fault_injector;
+         DramTraceSink::Buffer* m_trace;
 
          typedef std::unordered_map<IntPtr,UInt64> AccessCountMap;
          AccessCountMap* m_dram_access_count;
@@ -699,7 +699,7 @@ DramDirectoryCntlr::retrieveDataAndSendToL2Cache(ShmemMsg::msg_t reply_msg_type,
       // Remember that this request is waiting for data, and should not be woken up by voluntary invalidates
       shmem_req->setWaitForData(true);
 
-      core_id_t dram_node = m_dram_controller_home_lookup->getHome(address);
+      core_id_t dram_node = m_dram_controller_home_lookup->getHome(address, receiver);
 
       MYLOG("Sending request to DRAM for the data");
       getMemoryManager()->sendMsg(PrL1PrL2DramDirectoryMSI::ShmemMsg::DRAM_READ_REQ,
@@ -1214,8 +1214,8 @@ DramDirectoryCntlr::sendDataToNUCA(IntPtr address, core_id_t requester, Byte* da
 
       if (eviction)
       {
-         // Write data to Dram
-         core_id_t dram_node = m_dram_controller_home_lookup->getHome(evict_address);
+         // Write data to Dram, the eviction is charged to the requester whose write caused it
+         core_id_t dram_node = m_dram_controller_home_lookup->getHome(evict_address, requester);
 
          getMemoryManager()->sendMsg(PrL1PrL2DramDirectoryMSI::ShmemMsg::DRAM_WRITE_REQ,
                MemComponent::TAG_DIR, MemComponent::DRAM,
@@ -1245,7 +1245,7 @@ DramDirectoryCntlr::sendDataToDram(IntPtr address, core_id_t requester, Byte* da
    else
    {
       // Write data to Dram
-      core_id_t dram_node = m_dram_controller_home_lookup->getHome(address);
+      core_id_t dram_node = m_dram_controller_home_lookup->getHome(address, requester);
 
       getMemoryManager()->sendMsg(PrL1PrL2DramDirectoryMSI::ShmemMsg::DRAM_WRITE_REQ,
             MemComponent::TAG_DIR, MemComponent::DRAM,
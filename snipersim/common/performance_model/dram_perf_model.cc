@@ -3,6 +3,8 @@
 #include "dram_perf_model_constant.h"
 #include "dram_perf_model_readwrite.h"
 #include "dram_perf_model_normal.h"
+#include "dram_perf_model_ramulator.h"
+#include "dram_perf_model_banked.h"
 #include "config.hpp"
 
 DramPerfModel* DramPerfModel::createDramPerfModel(core_id_t core_id, UInt32 cache_block_size)
@@ -21,6 +23,14 @@ DramPerfModel* DramPerfModel::createDramPerfModel(core_id_t core_id, UInt32 cach
    {
       return new DramPerfModelNormal(core_id, cache_block_size);
    }
+   else if (type == "ramulator")
+   {
+      return new DramPerfModelRamulator(core_id, cache_block_size);
+   }
+   else if (type == "banked")
+   {
+      return new DramPerfModelBanked(core_id, cache_block_size);
+   }
    else
    {
       LOG_PRINT_ERROR("Invalid DRAM model type %s", type.c_str());
@@ -0,0 +1,197 @@
+#include "dram_perf_model_banked.h"
+#include "simulator.h"
+#include "config.h"
+#include "config.hpp"
+#include "stats.h"
+#include "shmem_perf.h"
+#include "log.h"
+
+static SubsecondTime getTimingNS(String key)
+{
+   return SubsecondTime::FS() * static_cast<uint64_t>(TimeConverter<float>::NStoFS(Sim()->getCfg()->getFloat("perf_model/dram/banked/" + key))); // Operate in fs for higher precision before converting to uint64_t/SubsecondTime
+}
+
+DramPerfModelBanked::DramPerfModelBanked(core_id_t core_id,
+      UInt32 cache_block_size):
+   DramPerfModel(core_id, cache_block_size),
+   m_cache_block_size(cache_block_size),
+   m_num_channels(Sim()->getCfg()->getInt("perf_model/dram/banked/channels")),
+   m_num_ranks(Sim()->getCfg()->getInt("perf_model/dram/banked/ranks")),
+   m_num_banks(Sim()->getCfg()->getInt("perf_model/dram/banked/banks")),
+   m_blocks_per_row(Sim()->getCfg()->getInt("perf_model/dram/banked/row_size") / cache_block_size),
+   m_open_page(Sim()->getCfg()->getString("perf_model/dram/banked/page_policy") == "open"),
+   m_controller_latency(getTimingNS("controller_latency")),
+   m_tRCD(getTimingNS("tRCD")),
+   m_tCL(getTimingNS("tCL")),
+   m_tRP(getTimingNS("tRP")),
+   m_tRAS(getTimingNS("tRAS")),
+   m_tREFI(getTimingNS("tREFI")),
+   m_tRFC(getTimingNS("tRFC")),
+   // The controller's bandwidth is split over its channels
+   m_channel_bandwidth(8 * Sim()->getCfg()->getFloat("perf_model/dram/per_controller_bandwidth") / Sim()->getCfg()->getInt("perf_model/dram/banked/channels")), // Convert bytes to bits
+   m_row_hits(0),
+   m_row_misses(0),
+   m_row_conflicts(0),
+   m_refreshes(0),
+   m_total_bank_delay(SubsecondTime::Zero()),
+   m_total_queueing_delay(SubsecondTime::Zero()),
+   m_total_access_latency(SubsecondTime::Zero())
+{
+   String page_policy = Sim()->getCfg()->getString("perf_model/dram/banked/page_policy");
+   LOG_ASSERT_ERROR(page_policy == "open" || page_policy == "closed", "Invalid perf_model/dram/banked/page_policy %s", page_policy.c_str());
+   LOG_ASSERT_ERROR(m_num_channels > 0 && m_num_ranks > 0 && m_num_banks > 0, "perf_model/dram/banked needs at least one channel, rank and bank");
+   LOG_ASSERT_ERROR(m_blocks_per_row > 0, "perf_model/dram/banked/row_size must be at least the cache block size (%u)", cache_block_size);
+   LOG_ASSERT_ERROR(m_tRFC < m_tREFI, "perf_model/dram/banked/tRFC must be shorter than tREFI");
+
+   Bank bank = { NO_ROW, SubsecondTime::Zero(), SubsecondTime::Zero(), SubsecondTime::Zero(), SubsecondTime::Zero() };
+   m_banks.resize(m_num_channels * m_num_ranks * m_num_banks, bank);
+   m_refresh_epoch.resize(m_num_channels * m_num_ranks, 0);
+
+   if (Sim()->getCfg()->getBool("perf_model/dram/queue_model/enabled"))
+   {
+      for (UInt32 channel = 0; channel < m_num_channels; ++channel)
+         m_queue_models.push_back(QueueModel::create("dram-queue-" + itostr(channel), core_id, Sim()->getCfg()->getString("perf_model/dram/queue_model/type"),
+                                                     m_channel_bandwidth.getRoundedLatency(8 * cache_block_size))); // bytes to bits
+   }
+
+   registerStatsMetric("dram", core_id, "total-access-latency", &m_total_access_latency);
+   registerStatsMetric("dram", core_id, "total-queueing-delay", &m_total_queueing_delay);
+   registerStatsMetric("dram", core_id, "total-bank-delay", &m_total_bank_delay);
+   registerStatsMetric("dram", core_id, "row-hits", &m_row_hits);
+   registerStatsMetric("dram", core_id, "row-misses", &m_row_misses);
+   registerStatsMetric("dram", core_id, "row-conflicts", &m_row_conflicts);
+   registerStatsMetric("dram", core_id, "refreshes", &m_refreshes);
+}
+
+DramPerfModelBanked::~DramPerfModelBanked()
+{
+   for (std::vector<QueueModel*>::iterator it = m_queue_models.begin(); it != m_queue_models.end(); ++it)
+      delete *it;
+   m_queue_models.clear();
+}
+
+// Returns the earliest time from time on at which the rank is not refreshing, and closes its rows when an access
+// reaches a new refresh interval
+SubsecondTime
+DramPerfModelBanked::refresh(UInt32 rank_id, SubsecondTime time)
+{
+   UInt64 epoch = time.getFS() / m_tREFI.getFS();
+   SubsecondTime refresh_start = m_tREFI * epoch;
+
+   if (epoch > m_refresh_epoch[rank_id])
+   {
+      m_refresh_epoch[rank_id] = epoch;
+      for (UInt32 bank_id = rank_id * m_num_banks; bank_id < (rank_id + 1) * m_num_banks; ++bank_id)
+      {
+         Bank &bank = m_banks[bank_id];
+         bank.open_row = NO_ROW;
+         bank.next_act = std::max(bank.next_act, refresh_start + m_tRFC);
+      }
+      m_refreshes ++;
+   }
+
+   return std::max(time, refresh_start + m_tRFC);
+}
+
+SubsecondTime
+DramPerfModelBanked::getAccessLatency(SubsecondTime pkt_time, UInt64 pkt_size, core_id_t requester, IntPtr address, DramCntlrInterface::access_t access_type, ShmemPerf *perf)
+{
+   // pkt_size is in 'Bytes'
+   // m_channel_bandwidth is in 'Bits per clock cycle'
+   if ((!m_enabled) ||
+         (requester >= (core_id_t) Config::getSingleton()->getApplicationCores()))
+   {
+      return SubsecondTime::Zero();
+   }
+
+   // Block address -> row:rank:bank:channel:column, with the bank permuted by the row so that strides that are a
+   // multiple of the bank stride (or address bits that select this controller) do not all hit the same bank
+   UInt64 block = address / m_cache_block_size;
+   UInt64 rest = block / m_blocks_per_row;
+   UInt32 channel = rest % m_num_channels;
+   rest /= m_num_channels;
+   UInt32 bank_in_rank = rest % m_num_banks;
+   rest /= m_num_banks;
+   UInt32 rank = rest % m_num_ranks;
+   UInt64 row = rest / m_num_ranks;
+   bank_in_rank = (bank_in_rank + row) % m_num_banks;
+
+   UInt32 rank_id = channel * m_num_ranks + rank;
+   Bank &bank = m_banks[rank_id * m_num_banks + bank_in_rank];
+
+   // Only accesses that are not older than the latest one to this bank wait for it
+   SubsecondTime arrival = pkt_time + m_controller_latency;
+   SubsecondTime start = arrival;
+   if (pkt_time >= bank.last_access)
+   {
+      start = std::max(start, bank.next_free);
+      bank.last_access = pkt_time;
+   }
+   start = refresh(rank_id, start);
+
+   SubsecondTime column;
+   if (bank.open_row == row)
+   {
+      column = start;
+      m_row_hits ++;
+   }
+   else
+   {
+      SubsecondTime activate = std::max(start, bank.next_act);
+      if (bank.open_row == NO_ROW)
+      {
+         m_row_misses ++;
+      }
+      else
+      {
+         activate = std::max(activate, bank.act_time + m_tRAS) + m_tRP;
+         m_row_conflicts ++;
+      }
+      bank.act_time = activate;
+      column = activate + m_tRCD;
+   }
+
+   SubsecondTime processing_time = m_channel_bandwidth.getRoundedLatency(8 * pkt_size); // bytes to bits
+   SubsecondTime data_ready = column + m_tCL;
+
+   // Column commands to the bank are spaced by a burst, closed-page banks precharge after the access
+   bank.next_free = std::max(bank.next_free, column + processing_time);
+   if (m_open_page)
+   {
+      bank.open_row = row;
+   }
+   else
+   {
+      bank.open_row = NO_ROW;
+      bank.next_act = std::max(bank.next_act, std::max(bank.act_time + m_tRAS, data_ready + processing_time) + m_tRP);
+   }
+
+   // Compute Queue Delay on the data bus of the channel
+   SubsecondTime queue_delay;
+   if (!m_queue_models.empty())
+   {
+      queue_delay = m_queue_models[channel]->computeQueueDelay(data_ready, processing_time, requester);
+   }
+   else
+   {
+      queue_delay = SubsecondTime::Zero();
+   }
+
+   SubsecondTime done = data_ready + queue_delay + processing_time;
+   SubsecondTime access_latency = done - pkt_time;
+   SubsecondTime bank_delay = start - arrival;
+
+
+   perf->updateTime(pkt_time);
+   perf->updateTime(start, ShmemPerf::DRAM_QUEUE);
+   perf->updateTime(data_ready, ShmemPerf::DRAM_DEVICE);
+   perf->updateTime(done, ShmemPerf::DRAM_BUS);
+
+   // Update Memory Counters
+   m_num_accesses ++;
+   m_total_access_latency += access_latency;
+   m_total_bank_delay += bank_delay;
+   m_total_queueing_delay += queue_delay;
+
+   return access_latency;
+}
@@ -0,0 +1,66 @@
+#ifndef __DRAM_PERF_MODEL_BANKED_H__
+#define __DRAM_PERF_MODEL_BANKED_H__
+
+#include "dram_perf_model.h"
+#include "queue_model.h"
+#include "fixed_types.h"
+#include "subsecond_time.h"
+#include "dram_cntlr_interface.h"
+
+#include <vector>
+
+// DRAM model with channels, ranks, banks and open rows (perf_model/dram/type = banked, see perf_model/dram/banked).
+//
+// Each access is mapped to a channel, rank, bank, row and column of this controller and is charged its row buffer
+// outcome: tCL on a row hit, tRCD + tCL on a closed bank, tRP + tRCD + tCL on a row conflict (not before tRAS
+// after the activation of the open row). Refresh blocks a rank for tRFC every tREFI and closes its rows.
+// The data burst then goes through a bandwidth queue per channel.
+//
+// Banks only keep next-free timestamps. Accesses arrive out of order in simulated time ("fluffy time"), so an access
+// is only delayed by a busy bank if it is not older than the latest access to that bank. Older accesses see the
+// current row buffer state but are not queued behind younger ones.
+
+class DramPerfModelBanked : public DramPerfModel
+{
+   private:
+      struct Bank
+      {
+         UInt64 open_row;           // NO_ROW if the bank is precharged
+         SubsecondTime last_access; // Latest pkt_time of an access to the bank
+         SubsecondTime next_free;   // Earliest time of the next column command
+         SubsecondTime next_act;    // Earliest time of the next activation (after tRP)
+         SubsecondTime act_time;    // Activation of the open row, for tRAS
+      };
+
+      static const UInt64 NO_ROW = ~UInt64(0);
+
+      UInt32 m_cache_block_size;
+      UInt32 m_num_channels, m_num_ranks, m_num_banks;
+      UInt32 m_blocks_per_row;
+      bool m_open_page;
+
+      SubsecondTime m_controller_latency;
+      SubsecondTime m_tRCD, m_tCL, m_tRP, m_tRAS, m_tREFI, m_tRFC;
+      ComponentBandwidth m_channel_bandwidth;
+
+      std::vector<Bank> m_banks;                 // Per channel x rank x bank
+      std::vector<UInt64> m_refresh_epoch;       // Per channel x rank, the last tREFI interval whose refresh closed the rows
+      std::vector<QueueModel*> m_queue_models;   // Data bus of each channel
+
+      UInt64 m_row_hits, m_row_misses, m_row_conflicts, m_refreshes;
+      SubsecondTime m_total_bank_delay;
+      SubsecondTime m_total_queueing_delay;
+      SubsecondTime m_total_access_latency;
+
+      SubsecondTime refresh(UInt32 rank_id, SubsecondTime time);
+
+   public:
+      DramPerfModelBanked(core_id_t core_id,
+            UInt32 cache_block_size);
+
+      ~DramPerfModelBanked();
+
+      SubsecondTime getAccessLatency(SubsecondTime pkt_time, UInt64 pkt_size, core_id_t requester, IntPtr address, DramCntlrInterface::access_t access_type, ShmemPerf *perf);
+};
+
+#endif /* __DRAM_PERF_MODEL_BANKED_H__ */
@@ -0,0 +1,170 @@
+#include "dram_perf_model_ramulator.h"
+#include "simulator.h"
+#include "config.h"
+#include "config.hpp"
+#include "stats.h"
+#include "shmem_perf.h"
+#include "lock.h"
+#include "log.h"
+
+#if SNIPER_RAMULATOR2
+#include "sniper_wrapper.h"
+#endif
+
+#include <unordered_map>
+
+#if SNIPER_RAMULATOR2
+
+// The Ramulator2 memory system shared by all DRAM controllers
+class DramPerfModelRamulator::Instance
+{
+   private:
+      Lock m_lock;
+      ramulator2_sim_t *m_sim;
+      UInt64 m_tck_fs;
+      UInt64 m_next_tag;
+      std::unordered_map<UInt64, UInt64> m_completed; // Tag -> cycle of the reads served but not yet picked up by their requester
+
+      void tick()
+      {
+         ramulator2_tick(m_sim);
+         UInt64 tag;
+         while (ramulator2_pop_completed(m_sim, &tag))
+            m_completed[tag] = ramulator2_get_clk(m_sim);
+      }
+
+      // Jumps over the idle cycles before the next one that may do work, but not beyond the cycle before until
+      void advance(UInt64 until)
+      {
+         UInt64 clk = ramulator2_get_clk(m_sim);
+         if (clk + 1 < until)
+            ramulator2_skip_idle(m_sim, until - clk - 1);
+         tick();
+      }
+
+   public:
+      Instance(String config_file)
+         : m_next_tag(0)
+      {
+         m_sim = ramulator2_create(config_file.c_str());
+         LOG_ASSERT_ERROR(m_sim != NULL, "Could not create Ramulator2 from perf_model/dram/ramulator/config_file = %s", config_file.c_str());
+         m_tck_fs = ramulator2_get_tck_ps(m_sim) * 1000;
+         LOG_ASSERT_ERROR(m_tck_fs > 0, "Ramulator2 memory system does not report its clock period");
+      }
+
+      ~Instance()
+      {
+         ramulator2_destroy(m_sim);
+      }
+
+      // Simulates one access arriving at pkt_time, returns the times it was accepted by and returned from the memory system
+      void access(SubsecondTime pkt_time, core_id_t requester, IntPtr address, bool is_write, SubsecondTime &t_issue, SubsecondTime &t_done)
+      {
+         ScopedLock sl(m_lock);
+
+         // Catch up with the requester. Accesses from threads that lag behind Ramulator2's clock are issued now.
+         UInt64 arrival = pkt_time.getFS() / m_tck_fs;
+         while (ramulator2_get_clk(m_sim) < arrival)
+            advance(arrival);
+
+         // Wait for a free slot in the controller's request buffer
+         UInt64 tag = m_next_tag++;
+         UInt64 start = ramulator2_get_clk(m_sim);
+         while (!ramulator2_send(m_sim, is_write, address, requester, tag))
+            tick();
+         UInt64 issue = ramulator2_get_clk(m_sim);
+
+         UInt64 done = issue;
+         if (!is_write)
+         {
+            // The lock is released between cycles, so that the accesses of other cores join this one in the memory
+            // system while it is in flight. Whichever waiting thread holds the lock advances the clock for all of them.
+            std::unordered_map<UInt64, UInt64>::iterator it;
+            while ((it = m_completed.find(tag)) == m_completed.end())
+            {
+               advance(UINT64_MAX);
+               m_lock.release();
+               m_lock.acquire();
+            }
+            done = it->second;
+            m_completed.erase(it);
+         }
+
+         // An access whose requester lags behind Ramulator2's clock is charged from the cycle it was sent, so that
+         // misses that overlap in Sniper overlap here as well instead of also paying for the lag
+         t_issue = pkt_time + SubsecondTime::FS((issue - start) * m_tck_fs);
+         t_done = t_issue + SubsecondTime::FS((done - issue) * m_tck_fs);
+      }
+};
+
+#endif
+
+DramPerfModelRamulator::Instance* DramPerfModelRamulator::s_instance = NULL;
+UInt32 DramPerfModelRamulator::s_num_users = 0;
+
+DramPerfModelRamulator::DramPerfModelRamulator(core_id_t core_id,
+      UInt32 cache_block_size):
+   DramPerfModel(core_id, cache_block_size),
+   m_total_queueing_delay(SubsecondTime::Zero()),
+   m_total_access_latency(SubsecondTime::Zero()),
+   m_num_reads(0),
+   m_num_writes(0)
+{
+#if SNIPER_RAMULATOR2
+   // Controllers are created sequentially during CoreManager construction
+   if (s_num_users++ == 0)
+      s_instance = new Instance(Sim()->getCfg()->getString("perf_model/dram/ramulator/config_file"));
+#else
+   LOG_PRINT_ERROR("perf_model/dram/type = ramulator requires Sniper to be built against Ramulator2 (set RAMULATOR2_HOME)");
+#endif
+
+   registerStatsMetric("dram", core_id, "total-access-latency", &m_total_access_latency);
+   registerStatsMetric("dram", core_id, "total-queueing-delay", &m_total_queueing_delay);
+   registerStatsMetric("dram", core_id, "ramulator-reads", &m_num_reads);
+   registerStatsMetric("dram", core_id, "ramulator-writes", &m_num_writes);
+}
+
+DramPerfModelRamulator::~DramPerfModelRamulator()
+{
+#if SNIPER_RAMULATOR2
+   if (--s_num_users == 0)
+   {
+      delete s_instance;
+      s_instance = NULL;
+   }
+#endif
+}
+
+SubsecondTime
+DramPerfModelRamulator::getAccessLatency(SubsecondTime pkt_time, UInt64 pkt_size, core_id_t requester, IntPtr address, DramCntlrInterface::access_t access_type, ShmemPerf *perf)
+{
+   if ((!m_enabled) ||
+         (requester >= (core_id_t) Config::getSingleton()->getApplicationCores()))
+   {
+      return SubsecondTime::Zero();
+   }
+
+   bool is_write = access_type == DramCntlrInterface::WRITE;
+   SubsecondTime t_issue = pkt_time, t_done = pkt_time;
+#if SNIPER_RAMULATOR2
+   s_instance->access(pkt_time, requester, address, is_write, t_issue, t_done);
+#endif
+
+   SubsecondTime queue_delay = t_issue - pkt_time;
+   SubsecondTime access_latency = t_done - pkt_time;
+
+   perf->updateTime(pkt_time);
+   perf->updateTime(t_issue, ShmemPerf::DRAM_QUEUE);
+   perf->updateTime(t_done, ShmemPerf::DRAM_DEVICE);
+
+   // Update Memory Counters
+   m_num_accesses ++;
+   if (is_write)
+      m_num_writes ++;
+   else
+      m_num_reads ++;
+   m_total_access_latency += access_latency;
+   m_total_queueing_delay += queue_delay;
+
+   return access_latency;
+}
@@ -0,0 +1,37 @@
+#ifndef __DRAM_PERF_MODEL_RAMULATOR_H__
+#define __DRAM_PERF_MODEL_RAMULATOR_H__
+
+#include "dram_perf_model.h"
+#include "fixed_types.h"
+#include "subsecond_time.h"
+#include "dram_cntlr_interface.h"
+
+// DRAM model that simulates every access online in an embedded Ramulator2 memory system
+// (perf_model/dram/type = ramulator, see perf_model/dram/ramulator).
+//
+// All DRAM controllers share one Ramulator2 instance, which models all channels itself. Ramulator2's clock
+// is advanced on demand up to the time of each access, reads then tick it until their completion callback
+// fires, writes return as soon as they are accepted into a write queue. Reads of different cores are in flight
+// together, each is matched to its completion by a per-request tag.
+
+class DramPerfModelRamulator : public DramPerfModel
+{
+   private:
+      class Instance;
+      static Instance *s_instance;
+      static UInt32 s_num_users;
+
+      SubsecondTime m_total_queueing_delay;
+      SubsecondTime m_total_access_latency;
+      UInt64 m_num_reads, m_num_writes;
+
+   public:
+      DramPerfModelRamulator(core_id_t core_id,
+            UInt32 cache_block_size);
+
+      ~DramPerfModelRamulator();
+
+      SubsecondTime getAccessLatency(SubsecondTime pkt_time, UInt64 pkt_size, core_id_t requester, IntPtr address, DramCntlrInterface::access_t access_type, ShmemPerf *perf);
+};
+
+#endif /* __DRAM_PERF_MODEL_RAMULATOR_H__ */